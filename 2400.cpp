@@ -3,14 +3,16 @@ A program that can help you check your answers to some types of MATH2400
 problems.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
 #include "base_conversion.h"
+#include "batch.h"
 #include "continued_fractions.h"
 #include "crt.h"
 #include "debug.h"
+#include "discrete_log.h"
 #include "euclidean.h"
 #include "linear_diophantine.h"
 #include "sieve.h"
@@ -24,7 +26,12 @@ void print_welcome(void);
 
 
 
-int32_t main(void) {
+int32_t main(int32_t argc, char **argv) {
+    // Arguments skip the menu, see print_usage() in batch.cpp.
+    if (argc > 1) {
+        return run_command_line(argc, argv);
+    }
+
     // Take the user's input then decide what to run.
     std::string input;
     print_welcome();
@@ -49,6 +56,26 @@ int32_t main(void) {
         return do_crt_congruences();
     } else if (input == "9") {
         return do_eratosthenes();
+    } else if (input == "10") {
+        return do_crt_batch();
+    } else if (input == "11") {
+        return do_fraction_digits();
+    } else if (input == "12") {
+        return do_best_approximation();
+    } else if (input == "13") {
+        return do_quadratic_cont_frac();
+    } else if (input == "14") {
+        return do_solve_pell();
+    } else if (input == "15") {
+        return do_cf_arithmetic();
+    } else if (input == "16") {
+        return do_lde_box();
+    } else if (input == "17") {
+        return do_lde_system();
+    } else if (input == "18") {
+        return do_lde_batch();
+    } else if (input == "19") {
+        return do_discrete_log();
     }
 
     // Since none of the above triggered, input is invalid.
@@ -80,6 +107,17 @@ void print_welcome(void) {
     std::cerr << " 7 - Linear Diophantine Solver\n";
     std::cerr << " 8 - Chinese Remainder Theorem (Linear Congruences)\n";
     std::cerr << " 9 - Sieve of Eratosthenes\n";
+    std::cerr << "10 - Chinese Remainder Theorem (Batch From File)\n";
+    std::cerr << "11 - Fraction Digits From Any Position\n";
+    std::cerr << "12 - Best Approximation With Bounded Denominator\n";
+    std::cerr << "13 - Continued Fraction of (P + sqrt(D)) / Q\n";
+    std::cerr << "14 - Pell Equation Solver\n";
+    std::cerr << "15 - Continued Fraction Arithmetic\n";
+    std::cerr << "16 - Linear Diophantine Solutions In A Box\n";
+    std::cerr << "17 - Systems Of Linear Diophantine Equations\n";
+    std::cerr << "18 - Linear Diophantine Solver (Batch From File)\n";
+    std::cerr << "19 - Discrete Logarithm\n";
+    std::cerr << "\nRun './2400 --help' to use these without the menu.\n";
 
     std::cerr << "\n";
     return;
@@ -1,18 +1,21 @@
 /*
 Implementation of base conversion functions.
 
-This is the newer version where decimal fraction base conversion is fast enough
-to perform 2.5 million iterations (instead of the old 25,000) but may not 
-produce the result with the shortest period.
+This is the newer version where decimal fraction base conversion finds the
+shortest period in closed form, and only generates the digits it prints.
 
 Written by Stephen Chuang.
-Last updated 27 March 2023.
+Last updated 18 October 2026.
 */
 
 
 #include "base_conversion.h"
 
 
+// Characters for the digits 0 to 35.
+static const char DIGIT_CHARS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+
 // The main code that runs integer base conversion.
 int do_integer_base_conversion(void) {
     print_limitations_int();
@@ -27,13 +30,24 @@ int do_integer_base_conversion(void) {
     int_vec digits;
     take_input_int(input, original_base, new_base, digits);
 
-    // Convert input to individual digits.
-    int decimal_val = to_decimal(digits, original_base);
-    
-    // Convert decimal number to new base.
-    int_vec result_v = dec_to_base_digits(decimal_val, new_base);
-    str result = digits_to_str(result_v, new_base);
-    std::cout << "\n" << input <<  " in base-" << new_base << ": " << result;
+    // Convert the digits to the new base. Power-of-two bases just regroup
+    // bits, and short integers fit in 64 bits and are written straight into a
+    // buffer.
+    std::cout << "\n" << input <<  " in base-" << new_base << ": ";
+    if (pow2_bits(original_base) && pow2_bits(new_base)) {
+        str result;
+        regroup_pow2(input, original_base, new_base, result);
+        std::cout << result;
+    } else if (digits.size() <= MAX_LENGTH) {
+        char buffer[MAX_DIGITS_64];
+        int decimal_val = to_decimal(digits, original_base);
+        size_t count = write_in_base(decimal_val, new_base, buffer,
+        MAX_DIGITS_64);
+        std::cout.write(buffer + MAX_DIGITS_64 - count, count);
+    } else {
+        int_vec result_v = convert_digits(digits, original_base, new_base);
+        std::cout << digits_to_str(result_v, new_base);
+    }
     std::cout << "\n\n";
     return 0;
 }
@@ -46,44 +60,51 @@ int do_fraction_base_conversion(void) {
     int original_num;
     int denominator;
     int new_base;
-    bool periodic = true;
     take_input_frac(original_num, denominator, new_base);
 
-    // Calculate the integer part and set numerator to numerator of fractional
-    // part only.
-    int int_part = original_num / denominator;
-    int numerator = original_num % denominator;
-
-    // Perform base conversion on integer part.
-    str converted_int = auto_dec_int_conversion(int_part, new_base);
-
-    // Vectors to store the integer and fractional parts after multiplying by
-    // the base.
-    int_vec numerators;
-    int_vec integer_parts;
-    numerators.reserve(MAX_ITERATIONS);
-    integer_parts.reserve(MAX_ITERATIONS);
+    // Find the preperiod and period first, then stream exactly those digits.
+    frac_expansion expansion = analyse_fraction(original_num, denominator,
+    new_base);
+    std::cout << "\n" << original_num << " / " << denominator << " in base-";
+    std::cout << new_base << ": ";
+    std::cout << auto_dec_int_conversion(expansion.int_part, new_base) << ".";
+    if (expansion.preperiod + expansion.period == 0) {
+        std::cout << "0";
+    }
+    stream_fraction(expansion, std::cout);
 
-    // Perform first iteration.
-    int product = numerator * new_base;
-    numerators.push_back(product % denominator);
-    integer_parts.push_back(product / denominator);
+    std::cout << "\n\nDigits before the period: " << expansion.preperiod;
+    std::cout << "\nDigits in the period: " << expansion.period << "\n\n";
+    return 0;
+}
 
-    // Finish the rest of the base conversion.
-    range_pair range;
-    range = frac_convert(numerators, denominator, integer_parts, new_base);
-    if (range.range_start == -1 || range.range_end == -1) {
-        periodic = false;
-    }
 
-    // Print the result.
-    if (!periodic && integer_parts.size() == MAX_ITERATIONS) {
-        std::cout << RED << "\n\nTerminated prematurely after ";
-        std::cout << MAX_ITERATIONS << " iterations.\n" << RESET;
+// The main code that prints the digits of a fraction from any position.
+int do_fraction_digits(void) {
+    int numerator;
+    int denominator;
+    int new_base;
+    int start;
+    int count;
+    take_input_frac(numerator, denominator, new_base);
+    take_input_digits(start, count);
+
+    // Each digit is found from base^start mod den, so nothing before start is
+    // generated. Long runs are printed a block at a time.
+    frac_expansion expansion = analyse_fraction(numerator, denominator,
+    new_base);
+    size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::cout << "\nDigits " << start << " to " << start + count - 1;
+    std::cout << " of " << numerator << " / " << denominator << " in base-";
+    std::cout << new_base << ":\n";
+    str digits;
+    for (int done = 0; done < count; done += DIGITS_BLOCK) {
+        int block = std::min((int)(DIGITS_BLOCK), count - done);
+        parallel_fraction_digits(expansion, start + done, block, threads,
+        digits);
+        std::cout << digits;
     }
-    std::cout << "\n" << original_num << " / " << denominator << " in base-";
-    std::cout << new_base << ": " << converted_int << ".";
-    print_result(integer_parts, periodic, range.range_start, range.range_end);
+    std::cout << "\n\n";
     return 0;
 }
 
@@ -92,8 +113,9 @@ int do_fraction_base_conversion(void) {
 void print_limitations_int(void) {
     std::cerr << "Limitations:\n";
     
-    std::cerr << "- Maximum string length is " << MAX_LENGTH << " chars ";
-    std::cerr << "(configurable in base_conversion.h).\n";
+    std::cerr << "- Integers longer than " << MAX_LENGTH << " chars use ";
+    std::cerr << "arbitrary precision, which takes about a second per million ";
+    std::cerr << "digits.\n";
     std::cerr << "- Maximum base of 36.\n\n";
     return;
 }
@@ -103,9 +125,8 @@ void print_limitations_int(void) {
 void print_limitations_frac(void) {
     std::cerr << "Limitations:\n";
     
-    std::cerr << "- This program rarely produces the simplest possible ";
-    std::cerr << "period.\n- Do your own checking by writing out the periodic ";
-    std::cerr << "part a few times to find the simplest possible period.\n\n";
+    std::cerr << "- Every digit of the shortest period is printed, which ";
+    std::cerr << "can be almost as many digits as the denominator.\n\n";
     return;
 }
 
@@ -134,14 +155,7 @@ void print_characters() {
 // Reads and validates input for integer base conversion.
 void take_input_int(str &in, int &old_base, int &new_base, int_vec &digits) {
     std::cerr << "Enter a positive integer: ";
-    if (std::cin >> in) {
-        // String read successfully. Check that it is a valid string.
-        if (in.length() > MAX_LENGTH) {
-            std::cerr << RED << "Error: integers this large may cause integer ";
-            std::cerr << "overflow.\n" << RESET;
-            exit(EXIT_FAILURE);
-        }
-    } else {
+    if (!(std::cin >> in)) {
         std::cerr << RED << "Error reading integer." << RESET << "\n";
         exit(EXIT_FAILURE);
     }
@@ -180,55 +194,246 @@ void take_input_int(str &in, int &old_base, int &new_base, int_vec &digits) {
 
 // Checks if a string is a valid number in its base, and stores the decimal
 // digits in a vector.
-void check_string(str input, int base, int_vec &digits) {
-    for (char ch : input) {    
-        // Convert letters to numbers.
-        int digit;
-        if (isdigit(ch)) {
-            digit = ch - '0';
-        } else if (islower(ch)) {
-            digit = ch - 'a' + 10;
-        } else if (isupper(ch)) {
-            digit = ch - 'A' + 10;
-        } else {
-            std::cerr << RED << "Error: invalid digit '" << ch << "'.\n";
-            std::cerr << RESET;
-            digits.~vector();
-            exit(EXIT_FAILURE);
+void check_string(const str &input, int base, int_vec &digits) {
+    size_t index;
+    int status = decode_digits(input, base, digits, index);
+    if (status == DIGITS_BAD_CHAR) {
+        std::cerr << RED << "Error: invalid digit '" << input[index] << "'.\n";
+        std::cerr << RESET;
+        exit(EXIT_FAILURE);
+    } else if (status == DIGITS_TOO_LARGE) {
+        int digit = decode_digit(input[index]);
+        std::cerr << RED << "Error: cannot have digit '" << input[index];
+        std::cerr << "' = " << digit << " in base-" << base << "." << '\n';
+        std::cerr << RESET;
+        exit(EXIT_FAILURE);
+    }
+
+    return;
+}
+
+
+// Maps every character to the digit it represents, or INVALID_DIGIT.
+typedef struct digit_table {
+    unsigned char values[256];
+} digit_table;
+
+
+// Fills in the table of digits. Letters of either case are 10 to 35.
+static digit_table make_digit_table(void) {
+    digit_table table;
+    for (int ch = 0; ch < 256; ++ch) {
+        table.values[ch] = INVALID_DIGIT;
+    }
+    for (int digit = 0; digit < 10; ++digit) {
+        table.values['0' + digit] = digit;
+    }
+    for (int letter = 0; letter < 26; ++letter) {
+        table.values['a' + letter] = letter + 10;
+        table.values['A' + letter] = letter + 10;
+    }
+    return table;
+}
+
+
+static const digit_table DIGITS = make_digit_table();
+
+
+// Returns the digit a character represents, or INVALID_DIGIT.
+int decode_digit(char ch) {
+    return DIGITS.values[(unsigned char)(ch)];
+}
+
+
+#if defined(__AVX2__)
+
+
+// Returns true if every character in data is a digit less than base, checking
+// 32 characters per step. Any leftover characters are checked with the table.
+static bool validate_digits(const char *data, size_t length, int base) {
+    // A character c is in [low, low + count) when (c - low) is at most
+    // count - 1 as an unsigned byte, and letters are folded to lower case.
+    int numerals = std::min(base, 10LL);
+    int letters = std::max(base - 10, 0LL);
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i numeral_max = _mm256_set1_epi8(numerals - 1);
+    const __m256i lower_a = _mm256_set1_epi8('a');
+    const __m256i letter_max = _mm256_set1_epi8(letters ? letters - 1 : 0);
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i has_letters = _mm256_set1_epi8(letters ? -1 : 0);
+
+    size_t index = 0;
+    for (; index + 32 <= length; index += 32) {
+        __m256i chars = _mm256_loadu_si256((const __m256i *)(data + index));
+        __m256i numeral = _mm256_sub_epi8(chars, zero);
+        __m256i numeral_ok = _mm256_cmpeq_epi8(numeral,
+        _mm256_min_epu8(numeral, numeral_max));
+        __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, case_bit),
+        lower_a);
+        __m256i letter_ok = _mm256_and_si256(has_letters,
+        _mm256_cmpeq_epi8(letter, _mm256_min_epu8(letter, letter_max)));
+        __m256i ok = _mm256_or_si256(numeral_ok, letter_ok);
+        if ((uint32_t)(_mm256_movemask_epi8(ok)) != 0xFFFFFFFFU) {
+            return false;
         }
+    }
 
-        if (digit >= base) {
-            std::cerr << RED << "Error: cannot have digit '" << ch << "' = ";
-            std::cerr << digit << " in base-" << base << "." << '\n';
-            std::cerr << RESET;
-            digits.~vector();
-            exit(EXIT_FAILURE);
+    for (; index < length; ++index) {
+        if (decode_digit(data[index]) >= base) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+#elif defined(__SSE2__)
+
+
+// Returns true if every character in data is a digit less than base, checking
+// 16 characters per step. Any leftover characters are checked with the table.
+static bool validate_digits(const char *data, size_t length, int base) {
+    // A character c is in [low, low + count) when (c - low) is at most
+    // count - 1 as an unsigned byte, and letters are folded to lower case.
+    int numerals = std::min(base, 10LL);
+    int letters = std::max(base - 10, 0LL);
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i numeral_max = _mm_set1_epi8(numerals - 1);
+    const __m128i lower_a = _mm_set1_epi8('a');
+    const __m128i letter_max = _mm_set1_epi8(letters ? letters - 1 : 0);
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i has_letters = _mm_set1_epi8(letters ? -1 : 0);
+
+    size_t index = 0;
+    for (; index + 16 <= length; index += 16) {
+        __m128i chars = _mm_loadu_si128((const __m128i *)(data + index));
+        __m128i numeral = _mm_sub_epi8(chars, zero);
+        __m128i numeral_ok = _mm_cmpeq_epi8(numeral,
+        _mm_min_epu8(numeral, numeral_max));
+        __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, case_bit), lower_a);
+        __m128i letter_ok = _mm_and_si128(has_letters,
+        _mm_cmpeq_epi8(letter, _mm_min_epu8(letter, letter_max)));
+        __m128i ok = _mm_or_si128(numeral_ok, letter_ok);
+        if (_mm_movemask_epi8(ok) != 0xFFFF) {
+            return false;
         }
+    }
 
-        digits.push_back(digit);
+    for (; index < length; ++index) {
+        if (decode_digit(data[index]) >= base) {
+            return false;
+        }
     }
-    
-    return;
+    return true;
 }
 
 
-// Convert to decimal.
-int to_decimal(int_vec digits, int base) {
-    int result = 0;
-    
-    int power = 0;
-    while (digits.size()) {
-        // Take the last digit remaining and raise to the right power.
-        int new_digit = digits[digits.size() - 1];
-        digits.pop_back();
-        result += new_digit * pow(base, power);
-        ++power;
+#else
+
+
+// Returns true if every character in data is a digit less than base.
+static bool validate_digits(const char *data, size_t length, int base) {
+    for (size_t index = 0; index < length; ++index) {
+        if (decode_digit(data[index]) >= base) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+#endif
+
+
+// Decodes the digits of input in a base from 2 to 36 into digits. Returns
+// DIGITS_VALID, or the kind of error with the index of the first bad character
+// in error_index.
+int decode_digits(const str &input, int base, int_vec &digits,
+size_t &error_index) {
+    size_t start = digits.size();
+    digits.resize(start + input.size());
+    int_vec::iterator out = digits.begin() + start;
+
+    // Validate in bulk first, so that valid input is decoded without a branch
+    // per character.
+    if (validate_digits(input.data(), input.size(), base)) {
+        for (size_t index = 0; index < input.size(); ++index) {
+            out[index] = decode_digit(input[index]);
+        }
+        return DIGITS_VALID;
+    }
+
+    // Something is wrong, so find the first bad character.
+    digits.resize(start);
+    for (size_t index = 0; index < input.size(); ++index) {
+        int digit = decode_digit(input[index]);
+        if (digit == INVALID_DIGIT || digit >= base) {
+            error_index = index;
+            return digit == INVALID_DIGIT ? DIGITS_BAD_CHAR : DIGITS_TOO_LARGE;
+        }
+    }
+    return DIGITS_VALID;
+}
+
+
+// Powers base^k for every base up to MAX_BASE and k up to DECIMAL_CHUNK.
+typedef struct power_table {
+    unsigned long long powers[MAX_BASE + 1][DECIMAL_CHUNK + 1];
+} power_table;
+
+
+// Fills in the table of powers. 36^8 is well within 64 bits.
+static power_table make_power_table(void) {
+    power_table table;
+    for (int base = 0; base <= MAX_BASE; ++base) {
+        table.powers[base][0] = 1;
+        for (int k = 1; k <= DECIMAL_CHUNK; ++k) {
+            table.powers[base][k] = table.powers[base][k - 1] * base;
+        }
+    }
+    return table;
+}
+
+
+static const power_table POWERS = make_power_table();
+
+
+// Convert to decimal. Exact for any value that fits in a 64-bit integer.
+int to_decimal(const int_vec &digits, int base) {
+    // Horner's method, DECIMAL_CHUNK digits at a time: each chunk is gathered
+    // in a small accumulator, then shifted in with one multiply by a power of
+    // the base from the table.
+    unsigned long long result = 0;
+    size_t index = 0;
+    while (index < digits.size()) {
+        size_t end = std::min(index + DECIMAL_CHUNK, digits.size());
+        unsigned long long chunk = 0;
+        for (size_t i = index; i < end; ++i) {
+            chunk = chunk * base + digits[i];
+        }
+        result = result * POWERS.powers[base][end - index] + chunk;
+        index = end;
     }
 
     return result;
 }
 
 
+// Converts digits in old_base, most significant first, to digits in new_base,
+// least significant first. Integers longer than MAX_LENGTH are converted with
+// big integers, so there is no limit on their length.
+int_vec convert_digits(const int_vec &digits, int old_base, int new_base) {
+    if (digits.size() <= MAX_LENGTH) {
+        return dec_to_base_digits(to_decimal(digits, old_base), new_base);
+    }
+
+    int_vec new_digits;
+    bigint value = bigint_from_digits(digits, old_base);
+    bigint_to_digits(value, new_base, new_digits);
+    return new_digits;
+}
+
+
 // Convert decimal to specified base.
 int_vec dec_to_base_digits(int decimal, int new_base) {
     int_vec new_digits;
@@ -265,30 +470,19 @@ bool check_remainder(int remainder) {
 
 
 // Converts digits into a number in the specified base.
-str digits_to_str(int_vec in_v, int new_base) {
-    str result = "";
-    while (in_v.size()) {
-        // Take the last digit remaining.
-        int new_digit = in_v[in_v.size() - 1];
-        
-        char new_character = '\0';
+str digits_to_str(const int_vec &in_v, int new_base) {
+    // The digits are least significant first, so fill the string from the end.
+    str result(in_v.size(), '0');
+    for (size_t index = 0; index < in_v.size(); ++index) {
+        int new_digit = in_v[index];
         if (new_digit >= new_base) {
             // Digit produced that is greater than or equal to new base.
             std::cerr << RED << "Error: invalid digit " << new_digit;
             std::cerr << " produced when converting to base-" << new_base;
             std::cerr << ".\n" << RESET;
-            in_v.~vector();
             exit(EXIT_FAILURE);
-        } else if (new_digit < 10) {
-            // Digit has value less than 10.
-            new_character = new_digit + '0';
-        } else {
-            // Digit has value greater than 10, represent with a letter.
-            new_character = new_digit - 10 + 'A';
         }
-
-        result += new_character;
-        in_v.pop_back();
+        result[in_v.size() - 1 - index] = DIGIT_CHARS[new_digit];
     }
 
     return result;
@@ -297,15 +491,13 @@ str digits_to_str(int_vec in_v, int new_base) {
 
 // Reads and validates user input for the fraction base conversion algorithm.
 void take_input_frac(int &num, int &den, int &base) {
-    std::cerr << "This program terminates after " << MAX_ITERATIONS;
-    std::cerr << " iterations.\n\n";
-    
     // Read the numerator.
     std::cerr << "Enter base-10 numerator: ";
     if (std::cin >> num) {
-        // Numerator read successfully.
-        if (num > MAX_INT) {
-            std::cerr << RED << "Error: numerator too large." << RESET << "\n";
+        // Numerator read successfully. Anything up to 2^63 - 1 fits.
+        if (num < 0) {
+            std::cerr << RED << "Error: numerator must not be negative.";
+            std::cerr << RESET << "\n";
             exit(EXIT_FAILURE);
         }
     } else {
@@ -316,8 +508,9 @@ void take_input_frac(int &num, int &den, int &base) {
     // Read the denominator.
     std::cerr << "Enter base-10 denominator: ";
     if (std::cin >> den) {
-        if (den > MAX_INT) {
-            std::cerr << RED << "Error: denominator too large.\n" << RESET;
+        if (den <= 0) {
+            std::cerr << RED << "Error: denominator must be positive.\n";
+            std::cerr << RESET;
             exit(EXIT_FAILURE);
         }
     } else {
@@ -326,9 +519,9 @@ void take_input_frac(int &num, int &den, int &base) {
     }
     
     // Read the new base.
-    std::cerr << "Enter base to convert to (2 - 10): ";
+    std::cerr << "Enter base to convert to (2 - " << MAX_BASE << "): ";
     if (std::cin >> base) {
-        if (base < 2 || base > 10) {
+        if (base < 2 || base > MAX_BASE) {
             std::cerr << RED << "Error: invalid base.\n" << RESET;
             exit(EXIT_FAILURE);
         }
@@ -341,260 +534,432 @@ void take_input_frac(int &num, int &den, int &base) {
 }
 
 
-// Performs the base conversion algorithm on fractional parts.
-range_pair frac_convert(int_vec &num, int den, int_vec &ints, int base) {
-    range_pair result;
-    int product;
-    int new_numer;
+// Finds the integer part, preperiod and shortest period of num / den in base
+// without generating any digits. The preperiod comes from the primes den
+// shares with base, and the period is the multiplicative order of base modulo
+// what is left of den.
+frac_expansion analyse_fraction(int num, int den, int base) {
+    frac_expansion expansion;
+    expansion.int_part = num / den;
+    expansion.den = den;
+    expansion.base = base;
+    expansion.remainder = num % den;
+    expansion.preperiod = 0;
+    expansion.period = 0;
+    if (expansion.remainder == 0) {
+        return expansion;
+    }
+
+    // Each digit clears one factor of base from the reduced denominator. The
+    // preperiod ends once no prime of base is left.
+    int reduced = den / gcd(expansion.remainder, den);
+    for (int common = gcd(reduced, base); common > 1;
+    common = gcd(reduced, base)) {
+        reduced /= common;
+        ++expansion.preperiod;
+    }
+
+    // After the preperiod the remainders cycle with the order of base.
+    if (reduced > 1) {
+        expansion.period = multiplicative_order(base, reduced);
+    }
+    return expansion;
+}
+
 
-    if (den < LARGE_THRESHOLD) {
-        return frac_convert_set(num, den, ints, base);
+// Writes count fractional digits of an expansion to out, starting from the
+// digit at index start.
+static void write_fraction_digits(const frac_expansion &expansion, int start,
+int count, char *out) {
+    int den = expansion.den;
+    int base = expansion.base;
+    int remainder = (uint128)(mod_pow(base, start, den)) * expansion.remainder
+    % den;
+
+    // 128-bit division is much slower, so it is only used when remainder *
+    // base could overflow.
+    if (den <= INT64_MAX / base) {
+        for (int index = 0; index < count; ++index) {
+            int product = remainder * base;
+            out[index] = DIGIT_CHARS[product / den];
+            remainder = product % den;
+        }
     } else {
-        // MAX_ITERATIONS prevents infinite looping.
-        while (num.size() < MAX_ITERATIONS && num[num.size() - 1]) {
-            // Multiply numerator by the base.
-            product = num[num.size() - 1] * base;
-            new_numer = product % den;
-            int new_integer_part = product / den;
-
-            num.push_back(new_numer);
-            ints.push_back(new_integer_part);
+        for (int index = 0; index < count; ++index) {
+            uint128 product = (uint128)(remainder) * base;
+            out[index] = DIGIT_CHARS[(int)(product / den)];
+            remainder = product % den;
         }
+    }
+    return;
+}
 
-        // Search for cycles. If a cycle is found, the expansion is periodic.
-        result = find_repeat(num);
-        if (result.range_start != -1 && result.range_end != -1) {
-            // Cycle found.
-            std::cout << "\nThis base conversion is periodic. The periodic ";
-            std::cout << "part will be highlighted in " << BLUE << "blue";
-            std::cout << RESET << ".\n";
-        } else if (num.size() < MAX_ITERATIONS) {
-            // No cycle found.
-            std::cout << "\nThis base conversion is terminating.\n";
-        }
 
-        return result;
-    }
+// Appends count fractional digits of an expansion to digits, starting from the
+// digit at index start. Jumps straight to start, so any part of the expansion
+// can be generated without the digits before it.
+void fraction_digits(const frac_expansion &expansion, int start, int count,
+str &digits) {
+    size_t old_size = digits.size();
+    digits.resize(old_size + count);
+    write_fraction_digits(expansion, start, count, &digits[old_size]);
+    return;
 }
 
 
-// Finds if there are any repeats of the first numerator.
-range_pair find_repeat(int_vec num) {    
-    // A range_pair store the return value.
-    range_pair return_val;
-    // Two pointers.
-    size_t tortoise_index = 1;
-    size_t hare_index = 2;
-    
-    while (tortoise_index < num.size()
-    && num[tortoise_index] != num[hare_index]) {
-        // Increment tortoise by 1, hare by 2. If hare goes beyond end of the
-        // vector, make it return to the start.
-        ++tortoise_index;
-        hare_index += 2;
-        if (hare_index >= num.size()) {
-            hare_index %= num.size();
-        }
+// Fills digits with count fractional digits of an expansion, starting from the
+// digit at index start. Long runs are split into chunks that are generated at
+// the same time on the given number of threads.
+void parallel_fraction_digits(const frac_expansion &expansion, int start,
+int count, size_t threads, str &digits) {
+    digits.resize(count);
+    int chunks = (count + FRACTION_CHUNK - 1) / FRACTION_CHUNK;
+    if (threads <= 1 || chunks <= 1) {
+        write_fraction_digits(expansion, start, count, &digits[0]);
+        return;
     }
 
-    // Tortoise and hare algorithm has finished.
-    if (tortoise_index == num.size()) {
-        // No match found.
-        return_val.range_start = -1;
-        return_val.range_end = -1;
-        return return_val;
-    } else {
-        // Repeat found.
-        return_val = subsequence_repeat(num, hare_index);
+    // Every chunk jumps to its own starting digit, so chunks do not depend on
+    // each other and each writes only its own part of digits.
+    thread_pool pool;
+    init_thread_pool(pool, std::min(threads, (size_t)(chunks)));
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        submit_task(pool, [&, chunk](size_t) {
+            int offset = chunk * FRACTION_CHUNK;
+            int length = std::min((int)(FRACTION_CHUNK), count - offset);
+            write_fraction_digits(expansion, start + offset, length,
+            &digits[offset]);
+        });
     }
-    return return_val;
+    wait_for_tasks(pool);
+    stop_thread_pool(pool);
+    return;
 }
 
 
-// Finds the earliest repeat in a sequence and returns the indices of the
-// start and end.
-range_pair subsequence_repeat(int_vec sequence, size_t end) {
-    // Store the return value. Initialised later.
-    range_pair result;
-
-    // Move the tortoise back to the start to search for the start of the 
-    // repeating cycle.
-    size_t tortoise_index = 0;
-    size_t hare_index = end;
-    while (hare_index < sequence.size()
-    && sequence[tortoise_index] != sequence[hare_index]) {
-        // Move both at same speed until a match is found.
-        ++tortoise_index;
-        ++hare_index;
+// Reads the position of the first digit and the number of digits to print.
+void take_input_digits(int &start, int &count) {
+    std::cerr << "Enter position of the first digit (0 is the first digit ";
+    std::cerr << "after the point): ";
+    if (!(std::cin >> start) || start < 0) {
+        std::cerr << RED << "Error: invalid position." << RESET << "\n";
+        exit(EXIT_FAILURE);
     }
 
-    if (hare_index == sequence.size()) {
-        // No repeat found.
-        result.range_start = -1;
-        result.range_end = -1;
-        return result;
-    } else {
-        // Tortoise and hare have same value. Find the first instance of the
-        // repeat.
-        int test_number = sequence[tortoise_index];
-        result.range_start = tortoise_index;
-        result.range_end = second_repeat(test_number, sequence) - 1;
-        return result;
+    std::cerr << "Enter number of digits: ";
+    if (!(std::cin >> count) || count <= 0) {
+        std::cerr << RED << "Error: invalid number of digits." << RESET;
+        std::cerr << "\n";
+        exit(EXIT_FAILURE);
+    } else if (count > INT64_MAX - start) {
+        // Digit positions up to start + count must fit in 64 bits.
+        std::cerr << RED << "Error: position plus number of digits must be ";
+        std::cerr << "at most " << INT64_MAX << "." << RESET << "\n";
+        exit(EXIT_FAILURE);
     }
+    return;
 }
 
 
-// Finds the earliest repeat of an element in the sequence.
-size_t second_repeat(int test_num, int_vec values) {
-    size_t index = 0;
-    int repeat_count = 0;
-    while (index < values.size() && repeat_count < 2) {
-        if (values[index] == test_num) {
-            ++repeat_count;
+// Writes every digit of the preperiod and then the period to out, with the
+// period in blue. Digits are generated a chunk at a time, so memory use does
+// not grow with the length of the expansion.
+void stream_fraction(const frac_expansion &expansion, std::ostream &out) {
+    str digits;
+    int length = expansion.preperiod + expansion.period;
+    for (int start = 0; start < length; start += FRACTION_CHUNK) {
+        int count = std::min((int)(FRACTION_CHUNK), length - start);
+        digits.clear();
+        fraction_digits(expansion, start, count, digits);
+
+        // Switch to blue partway through the chunk holding the period start.
+        if (start <= expansion.preperiod
+        && expansion.preperiod < start + count) {
+            int split = expansion.preperiod - start;
+            out.write(digits.data(), split);
+            out << BLUE;
+            out.write(digits.data() + split, count - split);
+        } else {
+            out << digits;
         }
-        ++index;
     }
+    out << RESET;
+    return;
+}
+
 
-    return index;
+// Performs decimal integer base conversion without having to read input from 
+// the user.
+str auto_dec_int_conversion(int value, int new_base) {
+    char buffer[MAX_DIGITS_64];
+    size_t count = write_in_base(value, new_base, buffer, MAX_DIGITS_64);
+    return str(buffer + MAX_DIGITS_64 - count, count);
 }
 
 
-// Fraction base conversion, but using std::unordered_set to track repeated 
-// numerators. Faster with smaller input.
-range_pair frac_convert_set(int_vec &num, int den, int_vec &ints, int base) {
-    std::unordered_set<int> seen_numerators;
-    seen_numerators.emplace(num[0]);
+// Every pair of digits in base-10 (00 to 99) and base-16 (00 to FF), so that
+// two digits can be written per division, and every byte as eight base-2
+// digits.
+typedef struct digit_pairs {
+    char decimal[2 * 100];
+    char hex[2 * 256];
+    char binary[8 * 256];
+} digit_pairs;
 
-    range_pair result = {-1, -1};
-    int product;
-    int new_numer;
-    
-    // MAX_ITERATIONS prevents infinite looping.
-    while (num.size() < MAX_ITERATIONS && num[num.size() - 1]) {
-        // Multiply numerator by the base.
-        product = num[num.size() - 1] * base;
-        new_numer = product % den;
-        int new_integer_part = product / den;
-
-        num.push_back(new_numer);
-        ints.push_back(new_integer_part);
-
-        if (seen_numerators.find(new_numer) != seen_numerators.end()) {
-            find_first_two(result, num, new_numer);
-            break;
-        } else {
-            seen_numerators.emplace(new_numer);
+
+// Fills in the tables of digit pairs.
+static digit_pairs make_digit_pairs(void) {
+    digit_pairs pairs;
+    for (int value = 0; value < 100; ++value) {
+        pairs.decimal[2 * value] = DIGIT_CHARS[value / 10];
+        pairs.decimal[2 * value + 1] = DIGIT_CHARS[value % 10];
+    }
+    for (int value = 0; value < 256; ++value) {
+        pairs.hex[2 * value] = DIGIT_CHARS[value >> 4];
+        pairs.hex[2 * value + 1] = DIGIT_CHARS[value & 0xF];
+        for (int bit = 0; bit < 8; ++bit) {
+            pairs.binary[8 * value + bit] = '0' + (value >> (7 - bit) & 1);
         }
     }
+    return pairs;
+}
+
 
-    if (result.range_start != -1 && result.range_end != -1) {
-        // Cycle found.
-        std::cout << "\nThis base conversion is periodic. The periodic ";
-        std::cout << "part will be highlighted in " << BLUE << "blue";
-        std::cout << RESET << ".\n";
-    } else if (num.size() < MAX_ITERATIONS) {
-        // No cycle found.
-        std::cout << "\nThis base conversion is terminating.\n";
+static const digit_pairs PAIRS = make_digit_pairs();
+
+
+// Returns the number of bits in one digit of base, or 0 if base is not a power
+// of two.
+int pow2_bits(int base) {
+    if (base < 2 || (base & (base - 1)) != 0) {
+        return 0;
     }
 
-    return result;
+    int bits = 0;
+    while ((1LL << bits) < base) {
+        ++bits;
+    }
+    return bits;
 }
 
 
-// Finds the indices of the first two instances of key in num.
-void find_first_two(range_pair &rp, int_vec num, int key) {
-    int first_index = -1;
-    int second_index = -1;
-
-    for (size_t index = 0; index < num.size(); ++index) {
-        if (first_index == -1 && num[index] == key) {
-            first_index = index;
-        } else if (first_index != -1 && num[index] == key) {
-            second_index = index;
-            rp.range_start = first_index;
-            rp.range_end = second_index;
-            return;
+// Writes out every whole output digit held in acc, right to left, leaving
+// fewer than out_bits bits. Base-2 digits are written a byte at a time.
+static void emit_regrouped(uint64_t &acc, int &acc_bits, int out_bits,
+char *&out) {
+    if (out_bits == 1) {
+        for (; acc_bits >= 8; acc_bits -= 8) {
+            out -= 8;
+            memcpy(out, PAIRS.binary + 8 * (acc & 0xFF), 8);
+            acc >>= 8;
         }
     }
 
+    uint64_t mask = (1ULL << out_bits) - 1;
+    for (; acc_bits >= out_bits; acc_bits -= out_bits) {
+        *--out = DIGIT_CHARS[acc & mask];
+        acc >>= out_bits;
+    }
     return;
 }
 
 
-// Prints the integer parts obtained from the fractional base conversion
-// algorithm.
-void print_result(int_vec int_parts, bool periodic, int start, int end) {  
-    if (periodic) {
-        print_periodic(int_parts, start, end);
-    } else {
-        for (int value : int_parts) {
-            std::cout << value;
+// Converts the digits in input from one power-of-two base to another by
+// regrouping their bits, for inputs of any length. input must already be
+// valid in old_base. The result has no leading zeros.
+void regroup_pow2(const str &input, int old_base, int new_base, str &output) {
+    int in_bits = pow2_bits(old_base);
+    int out_bits = pow2_bits(new_base);
+    size_t max_length = (input.size() * in_bits + out_bits - 1) / out_bits;
+    output.resize(std::max(max_length, (size_t)(1)));
+
+    // Bits flow from the least significant end of the input into acc, and
+    // leave as output digits written right to left.
+    char *end = &output[0] + output.size();
+    char *out = end;
+    uint64_t acc = 0;
+    int acc_bits = 0;
+    size_t index = input.size();
+
+#ifdef __BMI2__
+    // Eight digits at a time. Bytes are swapped so that the last character,
+    // the least significant digit, ends up in the lowest byte.
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t in_lanes = ones * (old_base - 1);
+    const uint64_t out_lanes = ones * (new_base - 1);
+    while (index >= 8) {
+        index -= 8;
+        uint64_t values;
+        if (in_bits <= 3) {
+            // Digits 0 to 7 are just their characters minus '0'.
+            memcpy(&values, input.data() + index, 8);
+            values = __builtin_bswap64(values) - ones * '0';
+        } else {
+            values = 0;
+            for (int k = 0; k < 8; ++k) {
+                values = values << 8 | decode_digit(input[index + k]);
+            }
+        }
+        acc |= _pext_u64(values, in_lanes) << acc_bits;
+        acc_bits += 8 * in_bits;
+
+        while (out_bits <= 3 && acc_bits >= 8 * out_bits) {
+            // Spread eight output digits into bytes and add '0' to each.
+            uint64_t digits = _pdep_u64(acc, out_lanes) + ones * '0';
+            digits = __builtin_bswap64(digits);
+            out -= 8;
+            memcpy(out, &digits, 8);
+            acc >>= 8 * out_bits;
+            acc_bits -= 8 * out_bits;
         }
+        emit_regrouped(acc, acc_bits, out_bits, out);
     }
-
-    if (!periodic && int_parts.size() == MAX_ITERATIONS) {
-        // The algorithm was stopped due to reaching maximum number of 
-        // iterations.
-        std::cerr << "\n\n" << RED << "Terminated prematurely after ";
-        std::cerr << MAX_ITERATIONS << " iterations.\n" << RESET;
-    } else {
-        std::cout << "\n";
+#endif
+
+    // Gather at least 32 bits between emits, so that base-2 output can be
+    // written a byte at a time.
+    while (index > 0) {
+        acc |= uint64_t(decode_digit(input[--index])) << acc_bits;
+        acc_bits += in_bits;
+        if (acc_bits >= 32) {
+            emit_regrouped(acc, acc_bits, out_bits, out);
+        }
+    }
+    emit_regrouped(acc, acc_bits, out_bits, out);
+    if (acc_bits > 0) {
+        *--out = DIGIT_CHARS[acc];
     }
 
-    std::cout << "\n";
+    // Drop leading zeros, keeping one digit for zero.
+    while (out < end - 1 && *out == '0') {
+        ++out;
+    }
+    output.erase(0, out - &output[0]);
     return;
 }
 
 
-// Prints the result if periodic.
-void print_periodic(int_vec int_parts, int start, int end) {
-    // Print the non-periodic part in default colour.
-    for (int index = 0; index <= start; ++index) {
-        std::cout << int_parts[index];
+// Writes value in a base from 2 to 36 into the end of buffer, right to left,
+// and returns how many characters were written. size must be at least
+// MAX_DIGITS_64. Nothing is allocated.
+size_t write_in_base(unsigned long long value, int base, char *buffer,
+size_t size) {
+    char *end = buffer + size;
+    char *out = end;
+    if (base == DECIMAL) {
+        while (value >= 100) {
+            out -= 2;
+            memcpy(out, PAIRS.decimal + 2 * (value % 100), 2);
+            value /= 100;
+        }
+        if (value >= 10) {
+            out -= 2;
+            memcpy(out, PAIRS.decimal + 2 * value, 2);
+        } else {
+            *--out = DIGIT_CHARS[value];
+        }
+    } else if (base == HEXADECIMAL) {
+        while (value >= 0x100) {
+            out -= 2;
+            memcpy(out, PAIRS.hex + 2 * (value & 0xFF), 2);
+            value >>= 8;
+        }
+        if (value >= 0x10) {
+            out -= 2;
+            memcpy(out, PAIRS.hex + 2 * value, 2);
+        } else {
+            *--out = DIGIT_CHARS[value];
+        }
+    } else if ((base & (base - 1)) == 0) {
+        // Powers of two take the digits straight from the bits.
+        int shift = 0;
+        while ((1LL << shift) < base) {
+            ++shift;
+        }
+        do {
+            *--out = DIGIT_CHARS[value & (base - 1)];
+            value >>= shift;
+        } while (value);
+    } else {
+        do {
+            *--out = DIGIT_CHARS[value % base];
+            value /= base;
+        } while (value);
     }
 
-    // Print the periodic part in blue.
-    std::cout << BLUE;
-    for (int index = start + 1; index <= end; ++index) {
-        std::cout << int_parts[index];
-    }
-    std::cout << RESET;
+    return end - out;
 }
 
 
-// Performs decimal integer base conversion without having to read input from 
-// the user.
-str auto_dec_int_conversion(int value, int new_base) {
-    // Perform integer base conversion algorithm and return result as a string.
-    str result = "";
+// Performs integer base conversion without reading input or printing
+// anything. Returns false with an error message in result if the input is
+// invalid. digits is scratch space, kept between calls so that short integers
+// are converted without allocating.
+bool silent_int_conversion(const str &in, int old_base, int new_base,
+int_vec &digits, str &result) {
+    if (old_base < 2 || old_base > MAX_BASE || new_base < 2
+    || new_base > MAX_BASE) {
+        result = "invalid base";
+        return false;
+    } else if (in.empty()) {
+        result = "empty integer";
+        return false;
+    }
 
-    // First iteration. Add remainder to string.
-    int quotient = value / new_base;
-    int remainder = value % new_base;
-    result += (remainder + '0');
+    // Power-of-two bases just regroup bits, at any length.
+    if (pow2_bits(old_base) && pow2_bits(new_base)
+    && validate_digits(in.data(), in.size(), old_base)) {
+        regroup_pow2(in, old_base, new_base, result);
+        return true;
+    }
 
-    // Keep performing further iterations until quotuent is zero.
-    while (quotient != 0) {
-        int new_value = quotient;
-        quotient = new_value / new_base;
-        remainder = new_value % new_base;
-        result += (remainder + '0');
+    // Same digit rules as check_string(), without exiting on failure.
+    size_t index;
+    digits.clear();
+    if (decode_digits(in, old_base, digits, index) != DIGITS_VALID) {
+        result = "invalid digit '" + str(1, in[index]) + "'";
+        return false;
     }
 
-    // Reverse string before returning it.
-    result = reverse_string(result);
-    return result;
+    // Short integers fit in 64 bits, as in do_integer_base_conversion().
+    if (digits.size() <= MAX_LENGTH) {
+        char buffer[MAX_DIGITS_64];
+        size_t count = write_in_base(to_decimal(digits, old_base), new_base,
+        buffer, MAX_DIGITS_64);
+        result.assign(buffer + MAX_DIGITS_64 - count, count);
+        return true;
+    }
+
+    result = digits_to_str(convert_digits(digits, old_base, new_base),
+    new_base);
+    return true;
 }
 
 
-// Reverses a string.
-str reverse_string(str input_str) {
-    str reversed = "";
+// Performs fraction base conversion of num / den without reading input or
+// printing anything. The periodic part is put in brackets, so 1 / 6 in base-10
+// is 0.1(6).
+str silent_frac_conversion(int num, int den, int base) {
+    str result = auto_dec_int_conversion(num / den, base);
+    int numerator = num % den;
+    if (numerator == 0) {
+        return result;
+    }
 
-    // Add elements to string in reverse order.
-    for (int index = input_str.size() - 1; index >= 0; --index) {
-        reversed += input_str[index];
+    // The lengths of the preperiod and period are known up front, so only the
+    // digits in the result are generated.
+    frac_expansion expansion = analyse_fraction(num, den, base);
+    int length = expansion.preperiod + expansion.period;
+    str digits;
+    if (length > MAX_ITERATIONS) {
+        fraction_digits(expansion, 0, MAX_ITERATIONS, digits);
+        return result + "." + digits + "...";
     }
 
-    return reversed;
-}
\ No newline at end of file
+    fraction_digits(expansion, 0, length, digits);
+    result += "." + digits.substr(0, expansion.preperiod);
+    if (expansion.period) {
+        result += "(" + digits.substr(expansion.preperiod) + ")";
+    }
+    return result;
+}
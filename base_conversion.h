@@ -2,7 +2,7 @@
 Header file for base conversion functions.
 
 Written by Stephen Chuang.
-Last updated 28 March 2023.
+Last updated 18 October 2026.
 */
 
 
@@ -14,26 +14,30 @@ Last updated 28 March 2023.
 #include <cmath>
 #include <iostream>
 #include <vector>
-#include <unordered_set>
+#include "bigint.h"
+#include "crt.h"
 #include "debug.h"
-
-
-typedef struct range_pair {
-    int range_start;
-    int range_end;
-} range_pair;
+#include "thread_pool.h"
 
 
 #define int long long
 #define int_vec std::vector<long long>
 #define str std::string
 
-#define MAX_LENGTH      12
+#define MAX_LENGTH      12         // Longer integers use big integers.
 #define MAX_BASE        36
+#define MAX_DIGITS_64   64         // Digits in a 64-bit integer in base-2.
+#define DECIMAL_CHUNK   8          // Digits read per multiply in to_decimal.
 #define MAX_INT         1000000000 // 10^9
-#define LARGE_THRESHOLD 100000     // 10^5
-#define MAX_ITERATIONS  2500000    // You may change this. O(n) time.
+#define MAX_ITERATIONS  2500000    // Digits in a single-line result.
 #define OLD_MAX_ITER    25000      // You may change this. O(n^2) time.
+#define FRACTION_CHUNK  65536      // Fraction digits generated at a time.
+#define DIGITS_BLOCK    16777216   // Digits printed at a time, 2^24.
+
+#define DIGITS_VALID     0 // Return values of decode_digits().
+#define DIGITS_BAD_CHAR  1
+#define DIGITS_TOO_LARGE 2
+#define INVALID_DIGIT    0xFF // Table entry for characters that are not digits.
 
 #define BINARY      2
 #define OCTAL       8
@@ -45,6 +49,19 @@ typedef struct range_pair {
 #define RESET "\033[0m"
 
 
+// The shape of the expansion of a fraction in some base: the integer part, the
+// remainder left for the fractional digits, and how many digits come before
+// the period and in it. A terminating expansion has a period of 0.
+typedef struct frac_expansion {
+    int int_part;
+    int remainder;
+    int den;
+    int base;
+    int preperiod;
+    int period;
+} frac_expansion;
+
+
 // The main code that runs integer base conversion.
 int do_integer_base_conversion(void);
 
@@ -53,6 +70,10 @@ int do_integer_base_conversion(void);
 int do_fraction_base_conversion(void);
 
 
+// The main code that prints the digits of a fraction from any position.
+int do_fraction_digits(void);
+
+
 // Prints limitations for the integer base conversion algorithm.
 void print_limitations_int(void);
 
@@ -71,11 +92,28 @@ void take_input_int(str &in, int &old_base, int &new_base, int_vec &digits);
 
 // Checks if a string is a valid number in its base, and stores the decimal
 // digits in a vector.
-void check_string(str input, int base, int_vec &digits);
+void check_string(const str &input, int base, int_vec &digits);
+
+
+// Returns the digit a character represents, or INVALID_DIGIT.
+int decode_digit(char ch);
+
+
+// Decodes the digits of input in a base from 2 to 36 into digits. Returns
+// DIGITS_VALID, or the kind of error with the index of the first bad character
+// in error_index.
+int decode_digits(const str &input, int base, int_vec &digits,
+size_t &error_index);
 
 
-// Convert to decimal.
-int to_decimal(int_vec digits, int base);
+// Convert to decimal. Exact for any value that fits in a 64-bit integer.
+int to_decimal(const int_vec &digits, int base);
+
+
+// Converts digits in old_base, most significant first, to digits in new_base,
+// least significant first. Integers longer than MAX_LENGTH are converted with
+// big integers, so there is no limit on their length.
+int_vec convert_digits(const int_vec &digits, int old_base, int new_base);
 
 
 // Convert decimal to digits of specified base.
@@ -87,56 +125,79 @@ bool check_remainder(int remainder);
 
 
 // Converts digits into a number in the specified base.
-str digits_to_str(int_vec in_v, int new_base);
+str digits_to_str(const int_vec &in_v, int new_base);
 
 
 // Reads and validates user input for the fraction base conversion algorithm.
 void take_input_frac(int &num, int &den, int &base);
 
 
-// Performs the base conversion algorithm on fractional parts.
-range_pair frac_convert(int_vec &num, int den, int_vec &ints, int base);
+// Finds the integer part, preperiod and shortest period of num / den in base
+// without generating any digits. The preperiod comes from the primes den
+// shares with base, and the period is the multiplicative order of base modulo
+// what is left of den.
+frac_expansion analyse_fraction(int num, int den, int base);
+
 
+// Appends count fractional digits of an expansion to digits, starting from the
+// digit at index start. Jumps straight to start, so any part of the expansion
+// can be generated without the digits before it.
+void fraction_digits(const frac_expansion &expansion, int start, int count,
+str &digits);
 
-// Finds if there are any repeats of the first numerator using the tortoise and
-// hare algorithm.
-range_pair find_repeat(int_vec num);
 
+// Fills digits with count fractional digits of an expansion, starting from the
+// digit at index start. Long runs are split into chunks that are generated at
+// the same time on the given number of threads.
+void parallel_fraction_digits(const frac_expansion &expansion, int start,
+int count, size_t threads, str &digits);
 
-// Finds the earliest repeat in a sequence and returns the indices of the
-// start and end.
-range_pair subsequence_repeat(int_vec sequence, size_t end);
 
+// Reads the position of the first digit and the number of digits to print.
+void take_input_digits(int &start, int &count);
 
-// Finds the second repeat of an element in the sequence.
-size_t second_repeat(int test_num, int_vec values);
 
+// Writes every digit of the preperiod and then the period to out, with the
+// period in blue. Digits are generated a chunk at a time, so memory use does
+// not grow with the length of the expansion.
+void stream_fraction(const frac_expansion &expansion, std::ostream &out);
 
-// Fraction base conversion, but using std::unordered_set to track repeated 
-// numerators. Faster with smaller input.
-range_pair frac_convert_set(int_vec &num, int den, int_vec &ints, int base);
+
+// Performs decimal integer base conversion without having to read input from 
+// the user.
+str auto_dec_int_conversion(int value, int new_base);
 
 
-// Finds the indices of the first two instances of key in num.
-void find_first_two(range_pair &rp, int_vec num, int key);
+// Returns the number of bits in one digit of base, or 0 if base is not a power
+// of two.
+int pow2_bits(int base);
 
 
-// Prints the integer parts obtained from the fractional base conversion
-// algorithm.
-void print_result(int_vec int_parts, bool periodic, int start, int end);
+// Converts the digits in input from one power-of-two base to another by
+// regrouping their bits, for inputs of any length. input must already be
+// valid in old_base. The result has no leading zeros.
+void regroup_pow2(const str &input, int old_base, int new_base, str &output);
 
 
-// Prints the result if periodic.
-void print_periodic(int_vec int_parts, int start, int end);
+// Writes value in a base from 2 to 36 into the end of buffer, right to left,
+// and returns how many characters were written. size must be at least
+// MAX_DIGITS_64. Nothing is allocated.
+size_t write_in_base(unsigned long long value, int base, char *buffer,
+size_t size);
 
 
-// Performs decimal integer base conversion without having to read input from 
-// the user.
-str auto_dec_int_conversion(int value, int new_base);
+// Performs integer base conversion without reading input or printing
+// anything. Returns false with an error message in result if the input is
+// invalid. digits is scratch space, kept between calls so that short integers
+// are converted without allocating.
+bool silent_int_conversion(const str &in, int old_base, int new_base,
+int_vec &digits, str &result);
 
 
-// Reverses a string.
-str reverse_string(str input_str);
+// Performs fraction base conversion of num / den without reading input or
+// printing anything. The periodic part is put in brackets, so 1 / 6 in base-10
+// is 0.1(6).
+str silent_frac_conversion(int num, int den, int base);
 
 
 #endif
@@ -0,0 +1,950 @@
+/*
+Implementation of the command line interface and batch mode.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#include "batch.h"
+
+
+// Reads the optional '--threads N' that may follow '--batch', starting from
+// argument number start. Returns false if the arguments are not valid.
+static bool parse_threads(int32_t argc, char **argv, int32_t start,
+size_t &threads) {
+    threads = std::max(std::thread::hardware_concurrency(), 1U);
+    if (argc == start) {
+        return true;
+    } else if (argc != start + 2 || str(argv[start]) != THREADS_FLAG) {
+        return false;
+    }
+
+    int_vec values;
+    if (!parse_ints(argv[start + 1], values) || values.size() != 1
+    || values[0] <= 0 || values[0] > MAX_BATCH_THREADS) {
+        return false;
+    }
+    threads = values[0];
+    return true;
+}
+
+
+// Runs a single job like run_job(), but turns anything the job throws, such as
+// running out of memory, into an error message instead of ending the program.
+static bool run_job_safely(const str &command, const str &args,
+job_buffers &buffers, str &result) {
+    try {
+        return run_job(command, args, buffers, result);
+    } catch (const std::bad_alloc &) {
+        result = "out of memory";
+    } catch (const std::exception &error) {
+        result = error.what();
+    }
+    return false;
+}
+
+
+// Runs the program from command line arguments. Returns the exit status.
+int run_command_line(int32_t argc, char **argv) {
+    str first = argv[1];
+    size_t threads;
+    if (first == HELP_FLAG) {
+        print_usage();
+        return 0;
+    } else if (first == BATCH_FLAG) {
+        if (!parse_threads(argc, argv, 2, threads)) {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+        return run_batch("", std::cin, std::cout, threads);
+    } else if (first == SERVE_COMMAND) {
+        return run_server(argc, argv);
+    } else if (argc == 2) {
+        return run_interactive_command(first);
+    } else if (str(argv[2]) == BATCH_FLAG) {
+        if (!parse_threads(argc, argv, 3, threads)) {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+        return run_batch(first, std::cin, std::cout, threads);
+    }
+
+    // Anything else is a single job with its arguments on the command line.
+    str args;
+    for (int32_t index = 2; index < argc; ++index) {
+        args += argv[index];
+        args += ' ';
+    }
+
+    job_buffers buffers;
+    init_job_buffers(buffers);
+    str result;
+    if (!run_job_safely(first, args, buffers, result)) {
+        std::cerr << RED << "Error: " << result << "." << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << result << "\n";
+    return 0;
+}
+
+
+// Prints how to use the command line interface.
+void print_usage(void) {
+    std::cerr << "Usage:\n";
+    std::cerr << "  2400                      Show the menu of options.\n";
+    std::cerr << "  2400 COMMAND              Run one algorithm ";
+    std::cerr << "interactively.\n";
+    std::cerr << "  2400 COMMAND ARGS...      Run one job and print the ";
+    std::cerr << "result.\n";
+    std::cerr << "  2400 COMMAND " << BATCH_FLAG << "      Run one job per ";
+    std::cerr << "line of input, each line holding ARGS.\n";
+    std::cerr << "  2400 " << BATCH_FLAG << "              Run one job per ";
+    std::cerr << "line of input, each line holding COMMAND ARGS.\n";
+    std::cerr << "  ... " << BATCH_FLAG << " " << THREADS_FLAG << " N   ";
+    std::cerr << "Run batch jobs on N threads (default: all cores).\n";
+    std::cerr << "  2400 " << SERVE_COMMAND << "                Answer ";
+    std::cerr << "COMMAND ARGS lines on stdin until it closes.\n";
+    std::cerr << "  2400 " << SERVE_COMMAND << " " << SOCKET_FLAG << " PATH  ";
+    std::cerr << "Answer COMMAND ARGS lines from clients of a Unix socket.\n\n";
+
+    std::cerr << "Commands and their ARGS:\n";
+    std::cerr << "  gcd a b                   GCD of a and b.\n";
+    std::cerr << "  eea a b                   'g x y' where g = xa + yb.\n";
+    std::cerr << "  base n b1 b2              n from base b1 to base b2.\n";
+    std::cerr << "  frac n d b                n / d in base b, with the ";
+    std::cerr << "period in brackets.\n";
+    std::cerr << "  digits n d b k len        Digits k to k + len - 1 after ";
+    std::cerr << "the point of n / d in base b.\n";
+    std::cerr << "  cf n d                    Continued fraction of n / d.\n";
+    std::cerr << "  convergents n d           Convergents of n / d.\n";
+    std::cerr << "  best n d N                Closest p/q to n / d with q at ";
+    std::cerr << "most N.\n";
+    std::cerr << "  qcf P D Q                 Continued fraction of (P + ";
+    std::cerr << "sqrt(D)) / Q.\n";
+    std::cerr << "  pell D s n                'x y', solution n of x^2 - Dy^2 ";
+    std::cerr << "= s (s is 1 or -1),\n";
+    std::cerr << "                            for n at most " << MAX_PELL_INDEX;
+    std::cerr << ".\n";
+    std::cerr << "  cfarith op P1 D1 Q1 P2 D2 Q2 n\n";
+    std::cerr << "                            First n terms of x op y, where ";
+    std::cerr << "x, y = (P + sqrt(D)) / Q.\n";
+    std::cerr << "  lde a b c                 'x0 xk y0 yk' where x = x0 + ";
+    std::cerr << "xk * k, y = y0 - yk * k.\n";
+    std::cerr << "  ldebox a b c x1 x2 y1 y2  'n x y x\' y\'', the number of ";
+    std::cerr << "solutions in the box and the first and last.\n";
+    std::cerr << "  ldesys m n A b            'x | v1 | v2 ...' solving the ";
+    std::cerr << "m equations A x = b in n variables.\n";
+    std::cerr << "  crt a1 b1 m1 a2 b2 m2 ... 'x m' solving every a_i x = b_i ";
+    std::cerr << "(mod m_i).\n";
+    std::cerr << "  powmod b e m              b^e mod m.\n";
+    std::cerr << "  dlog b a m                Smallest x with b^x = a (mod m).\n";
+    std::cerr << "  sieve n                   Primes up to and including n, ";
+    std::cerr << "for n at most " << LARGE_INPUT_SIZE << ".\n";
+    std::cerr << "  crt-batch                 Systems from a file (interactive ";
+    std::cerr << "only).\n";
+    std::cerr << "  lde-batch                 Equations a b c from a file ";
+    std::cerr << "(interactive only).\n\n";
+
+    std::cerr << "Results are printed one per line. Jobs that fail print a ";
+    std::cerr << "line starting with 'error:'.\n";
+    return;
+}
+
+
+// Runs the interactive version of a command. Returns the exit status.
+int run_interactive_command(const str &command) {
+    if (command == "gcd") {
+        return do_euclidean();
+    } else if (command == "eea") {
+        return do_extended_euclidean();
+    } else if (command == "base") {
+        return do_integer_base_conversion();
+    } else if (command == "frac") {
+        return do_fraction_base_conversion();
+    } else if (command == "digits") {
+        return do_fraction_digits();
+    } else if (command == "cf") {
+        return do_convert_cont_frac();
+    } else if (command == "convergents") {
+        return do_cont_frac_convergents();
+    } else if (command == "best") {
+        return do_best_approximation();
+    } else if (command == "qcf") {
+        return do_quadratic_cont_frac();
+    } else if (command == "pell") {
+        return do_solve_pell();
+    } else if (command == "cfarith") {
+        return do_cf_arithmetic();
+    } else if (command == "lde") {
+        return do_solve_lde();
+    } else if (command == "ldebox") {
+        return do_lde_box();
+    } else if (command == "ldesys") {
+        return do_lde_system();
+    } else if (command == "crt") {
+        return do_crt_congruences();
+    } else if (command == "dlog") {
+        return do_discrete_log();
+    } else if (command == "sieve") {
+        return do_eratosthenes();
+    } else if (command == "crt-batch") {
+        return do_crt_batch();
+    } else if (command == "lde-batch") {
+        return do_lde_batch();
+    }
+
+    std::cerr << RED << "Error: unknown command '" << command << "'" << RESET;
+    std::cerr << "\n\n";
+    print_usage();
+    return EXIT_FAILURE;
+}
+
+
+// Runs the job on one batch line, for either kind of batch.
+static void answer_batch_line(const str &command, const str &line,
+job_buffers &buffers, str &result) {
+    if (command.empty()) {
+        answer_job_line(line, buffers, result);
+    } else if (!run_job_safely(command, line, buffers, result)) {
+        result.insert(0, "error: ");
+    }
+    return;
+}
+
+
+// Reads one job per line from input and writes one result per line to output,
+// in the same order. If command is empty, each line starts with its own
+// command. Jobs run on the given number of threads. Returns the exit status.
+int run_batch(const str &command, std::istream &input, std::ostream &output,
+size_t threads) {
+    std::ios::sync_with_stdio(false);
+    input_buffer in;
+    output_buffer out;
+    init_input_buffer(in, input);
+    init_output_buffer(out, output);
+
+    // Everything here is reused from line to line.
+    str line;
+    str result;
+    if (threads <= 1) {
+        job_buffers buffers;
+        init_job_buffers(buffers);
+        while (read_line(in, line)) {
+            answer_batch_line(command, line, buffers, result);
+            write_str(out, result);
+            write_char(out, '\n');
+        }
+        flush_output(out);
+        return 0;
+    }
+
+    // Each worker has its own buffers and caches, so jobs never share state.
+    thread_pool pool;
+    init_thread_pool(pool, threads);
+    std::vector<job_buffers> buffers(threads);
+    for (job_buffers &worker_buffers : buffers) {
+        init_job_buffers(worker_buffers);
+    }
+
+    // A reorder buffer of BATCH_WINDOW slots. Lines are submitted as soon as
+    // a slot is free, and results are written in order as soon as the oldest
+    // one is ready, so a slow job only holds up the output, never the
+    // workers, which carry on with the lines behind it.
+    std::vector<str> lines(BATCH_WINDOW);
+    std::vector<str> results(BATCH_WINDOW);
+    std::vector<char> ready(BATCH_WINDOW, false);
+    std::mutex lock;
+    std::condition_variable finished;
+    size_t submitted = 0;
+    size_t written = 0;
+    bool more = true;
+    while (more || written < submitted) {
+        while (more && submitted - written < BATCH_WINDOW) {
+            size_t slot = submitted % BATCH_WINDOW;
+            if (!(more = read_line(in, lines[slot]))) {
+                break;
+            }
+            submit_task(pool, [&, slot](size_t worker) {
+                answer_batch_line(command, lines[slot], buffers[worker],
+                results[slot]);
+                std::lock_guard<std::mutex> guard(lock);
+                ready[slot] = true;
+                finished.notify_one();
+            });
+            ++submitted;
+        }
+
+        // Wait for the oldest result, then write every ready one after it.
+        std::unique_lock<std::mutex> guard(lock);
+        if (written < submitted) {
+            finished.wait(guard, [&]() {
+                return ready[written % BATCH_WINDOW];
+            });
+        }
+        while (written < submitted && ready[written % BATCH_WINDOW]) {
+            size_t slot = written % BATCH_WINDOW;
+            ready[slot] = false;
+            guard.unlock();
+            write_str(out, results[slot]);
+            write_char(out, '\n');
+            guard.lock();
+            ++written;
+        }
+    }
+
+    stop_thread_pool(pool);
+    flush_output(out);
+    return 0;
+}
+
+
+// Sets up empty buffers and caches for running jobs.
+void init_job_buffers(job_buffers &buffers) {
+    buffers.values.clear();
+    buffers.q.clear();
+    buffers.r.clear();
+    buffers.x.clear();
+    buffers.y.clear();
+    buffers.primes.limit = 0;
+    buffers.primes.primes.clear();
+    return;
+}
+
+
+// Runs the job on a line holding a command and its arguments, and sets
+// response to the line to send back, which starts with 'error: ' on failure.
+void answer_job_line(const str &line, job_buffers &buffers, str &response) {
+    split_job(line, buffers.command, buffers.args);
+    if (!run_job_safely(buffers.command, buffers.args, buffers, response)) {
+        response.insert(0, "error: ");
+    }
+    return;
+}
+
+
+// Splits a job line into its command and the rest of the line.
+void split_job(const str &line, str &command, str &args) {
+    size_t start = 0;
+    while (start < line.size() && isspace((unsigned char)(line[start]))) {
+        ++start;
+    }
+    size_t end = start;
+    while (end < line.size() && !isspace((unsigned char)(line[end]))) {
+        ++end;
+    }
+
+    command.assign(line, start, end - start);
+    args.assign(line, end, str::npos);
+    return;
+}
+
+
+// Runs a single job. Returns false with an error message in result if the job
+// could not be run.
+bool run_job(const str &command, const str &args, job_buffers &buffers,
+str &result) {
+    if (command == "gcd") {
+        return job_gcd(args, buffers, result);
+    } else if (command == "eea") {
+        return job_eea(args, buffers, result);
+    } else if (command == "base") {
+        return job_base(args, buffers, result);
+    } else if (command == "frac") {
+        return job_frac(args, buffers, result);
+    } else if (command == "digits") {
+        return job_digits(args, buffers, result);
+    } else if (command == "cf") {
+        return job_cf(args, buffers, result);
+    } else if (command == "convergents") {
+        return job_convergents(args, buffers, result);
+    } else if (command == "best") {
+        return job_best(args, buffers, result);
+    } else if (command == "qcf") {
+        return job_qcf(args, buffers, result);
+    } else if (command == "pell") {
+        return job_pell(args, buffers, result);
+    } else if (command == "cfarith") {
+        return job_cfarith(args, buffers, result);
+    } else if (command == "lde") {
+        return job_lde(args, buffers, result);
+    } else if (command == "ldebox") {
+        return job_ldebox(args, buffers, result);
+    } else if (command == "ldesys") {
+        return job_ldesys(args, buffers, result);
+    } else if (command == "crt") {
+        return job_crt(args, buffers, result);
+    } else if (command == "powmod") {
+        return job_powmod(args, buffers, result);
+    } else if (command == "dlog") {
+        return job_dlog(args, buffers, result);
+    } else if (command == "sieve") {
+        return job_sieve(args, buffers, result);
+    } else if (command.empty()) {
+        result = "empty job";
+        return false;
+    }
+
+    result = "unknown command '" + command + "'";
+    return false;
+}
+
+
+// Reads whitespace-separated integers from args into values. Returns false if
+// any token is not an integer.
+bool parse_ints(const str &args, int_vec &values) {
+    values.clear();
+    const char *cursor = args.c_str();
+    while (true) {
+        while (isspace((unsigned char)(*cursor))) {
+            ++cursor;
+        }
+        if (*cursor == '\0') {
+            return true;
+        }
+
+        char *end;
+        errno = 0;
+        int value = strtoll(cursor, &end, 10);
+        if (end == cursor || errno == ERANGE
+        || (*end != '\0' && !isspace((unsigned char)(*end)))) {
+            return false;
+        }
+        values.push_back(value);
+        cursor = end;
+    }
+}
+
+
+// Reads exactly count integers from args. Sets an error message and returns
+// false otherwise.
+static bool parse_exact(const str &args, size_t count, int_vec &values,
+str &result) {
+    if (!parse_ints(args, values) || values.size() != count) {
+        result = "expected " + std::to_string(count) + " integers";
+        return false;
+    }
+    return true;
+}
+
+
+// Job: 'gcd a b' gives the GCD of a and b.
+bool job_gcd(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 2, v, result)) {
+        return false;
+    } else if (v[0] <= 0 || v[1] <= 0) {
+        result = "inputs must be positive";
+        return false;
+    }
+
+    result = std::to_string(gcd(v[0], v[1]));
+    return true;
+}
+
+
+// Job: 'eea a b' gives 'g x y' where g = xa + yb.
+bool job_eea(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 2, v, result)) {
+        return false;
+    } else if (v[0] <= 0 || v[1] <= 0) {
+        result = "inputs must be positive";
+        return false;
+    }
+
+    buffers.q.clear();
+    buffers.r.clear();
+    buffers.x.clear();
+    buffers.y.clear();
+    auto_silent_eea(buffers.q, buffers.r, buffers.x, buffers.y, v[0], v[1]);
+    result = std::to_string(buffers.r[buffers.r.size() - 2]) + " "
+    + std::to_string(buffers.x[buffers.x.size() - 2]) + " "
+    + std::to_string(buffers.y[buffers.y.size() - 2]);
+    return true;
+}
+
+
+// Job: 'base n b1 b2' converts n from base b1 to base b2.
+bool job_base(const str &args, job_buffers &buffers, str &result) {
+    str number;
+    str bases;
+    split_job(args, number, bases);
+    if (!parse_exact(bases, 2, buffers.values, result)) {
+        result = "expected an integer and 2 bases";
+        return false;
+    }
+
+    int old_base = buffers.values[0];
+    int new_base = buffers.values[1];
+    return silent_int_conversion(number, old_base, new_base, buffers.q,
+    result);
+}
+
+
+// Job: 'frac n d b' converts n / d to base b.
+bool job_frac(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 3, v, result)) {
+        return false;
+    } else if (v[0] < 0 || v[1] <= 0) {
+        result = "numerator must be non-negative, denominator positive";
+        return false;
+    } else if (v[2] < 2 || v[2] > MAX_BASE) {
+        result = "base must be 2 to " + std::to_string(MAX_BASE);
+        return false;
+    }
+
+    result = silent_frac_conversion(v[0], v[1], v[2]);
+    return true;
+}
+
+
+// Job: 'digits n d b k len' gives the fractional digits of n / d in base b at
+// positions k to k + len - 1, where 0 is the first digit after the point.
+bool job_digits(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 5, v, result)) {
+        return false;
+    } else if (v[0] < 0 || v[1] <= 0) {
+        result = "numerator must be non-negative, denominator positive";
+        return false;
+    } else if (v[2] < 2 || v[2] > MAX_BASE) {
+        result = "base must be 2 to " + std::to_string(MAX_BASE);
+        return false;
+    } else if (v[3] < 0 || v[4] <= 0 || v[4] > MAX_ITERATIONS) {
+        result = "position must be non-negative and length 1 to "
+        + std::to_string(MAX_ITERATIONS);
+        return false;
+    } else if (v[4] > INT64_MAX - v[3]) {
+        // Digit positions up to position + length must fit in 64 bits.
+        result = "position plus length must be at most "
+        + std::to_string(INT64_MAX);
+        return false;
+    }
+
+    result.clear();
+    fraction_digits(analyse_fraction(v[0], v[1], v[2]), v[3], v[4], result);
+    return true;
+}
+
+
+// Runs 'cf n d' or 'convergents n d' with big integers, for when n or d do
+// not fit in 64 bits.
+static bool big_cf_job(const str &args, bool convergents, str &result) {
+    str first;
+    str second;
+    str rest;
+    split_job(args, first, rest);
+    split_job(rest, second, rest);
+    bigint n;
+    bigint d;
+    if (!rest.empty() || !bigint_from_string(first, n)
+    || !bigint_from_string(second, d)) {
+        result = "expected 2 integers";
+        return false;
+    } else if (n.negative || d.negative || bigint_is_zero(d)) {
+        result = "numerator must be non-negative, denominator positive";
+        return false;
+    }
+
+    std::vector<bigint> quotients;
+    big_cont_frac(n, d, quotients);
+    result.clear();
+    if (!convergents) {
+        for (size_t index = 0; index < quotients.size(); ++index) {
+            result += index == 0 ? "[" : index == 1 ? "; " : ", ";
+            result += bigint_to_string(quotients[index]);
+        }
+        result += "]";
+        return true;
+    }
+
+    big_convergent convergent;
+    init_big_convergent(convergent);
+    for (const bigint &quotient : quotients) {
+        next_big_convergent(convergent, quotient);
+        if (result.size()) {
+            result += ' ';
+        }
+        result += bigint_to_string(convergent.p) + "/"
+        + bigint_to_string(convergent.q);
+    }
+    return true;
+}
+
+
+// Job: 'cf n d' gives the continued fraction of n / d.
+bool job_cf(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_ints(args, v)) {
+        return big_cf_job(args, false, result);
+    } else if (!parse_exact(args, 2, v, result)) {
+        return false;
+    } else if (v[0] < 0 || v[1] <= 0) {
+        result = "numerator must be non-negative, denominator positive";
+        return false;
+    }
+
+    buffers.q.clear();
+    buffers.r.assign({v[0], v[1]});
+    silent_euclidean_vectors(buffers.q, buffers.r);
+
+    result = "[" + std::to_string(buffers.q[0]);
+    for (size_t index = 1; index < buffers.q.size(); ++index) {
+        result += index == 1 ? "; " : ", ";
+        result += std::to_string(buffers.q[index]);
+    }
+    result += "]";
+    return true;
+}
+
+
+// Job: 'convergents n d' gives the convergents of n / d.
+bool job_convergents(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_ints(args, v)) {
+        return big_cf_job(args, true, result);
+    } else if (!parse_exact(args, 2, v, result)) {
+        return false;
+    } else if (v[0] < 0 || v[1] <= 0) {
+        result = "numerator must be non-negative, denominator positive";
+        return false;
+    }
+
+    // Convergents of n / d never exceed n and d, so these cannot overflow.
+    convergent_stream stream;
+    init_convergent_stream(stream, v[0], v[1]);
+    result.clear();
+    while (next_convergent(stream)) {
+        if (result.size()) {
+            result += ' ';
+        }
+        result += std::to_string(stream.p) + "/" + std::to_string(stream.q);
+    }
+    return true;
+}
+
+
+// Job: 'best n d N' gives the closest p/q to n / d with q at most N.
+bool job_best(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 3, v, result)) {
+        return false;
+    } else if (v[0] < 0 || v[1] <= 0 || v[2] <= 0) {
+        result = "numerator must be non-negative, denominators positive";
+        return false;
+    }
+
+    int p;
+    int q;
+    best_approximation(v[0], v[1], v[2], p, q);
+    result = std::to_string(p) + "/" + std::to_string(q);
+    return true;
+}
+
+
+// Job: 'qcf P D Q' gives the periodic continued fraction of (P + sqrt(D)) / Q.
+bool job_qcf(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    size_t preperiod;
+    if (!parse_exact(args, 3, v, result)) {
+        return false;
+    }
+    int status = quadratic_cont_frac(v[0], v[1], v[2], buffers.q, preperiod);
+    if (status == QUADRATIC_NONE) {
+        result = "D must not be a square and the numbers at most 10^18";
+        return false;
+    } else if (status == QUADRATIC_TOO_LONG) {
+        result = "more than " + std::to_string(MAX_QUADRATIC_TERMS)
+        + " terms before the end of the period";
+        return false;
+    }
+
+    result = format_quadratic_cf(buffers.q, preperiod);
+    return true;
+}
+
+
+// Job: 'pell D s n' gives 'x y', the nth positive solution of x^2 - Dy^2 = s
+// for s = 1 or -1, or 'none'.
+bool job_pell(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 3, v, result)) {
+        return false;
+    } else if (v[0] <= 0 || v[0] > MAX_QUADRATIC_D) {
+        result = "D must be 1 to 10^18";
+        return false;
+    } else if (v[1] != 1 && v[1] != -1) {
+        result = "s must be 1 or -1";
+        return false;
+    } else if (v[2] <= 0 || v[2] > MAX_PELL_INDEX) {
+        result = "n must be 1 to " + std::to_string(MAX_PELL_INDEX);
+        return false;
+    }
+
+    bigint x;
+    bigint y;
+    int status = solve_pell(v[0], v[1] == -1, x, y);
+    if (status == QUADRATIC_TOO_LONG) {
+        result = "the period of sqrt(D) has more than "
+        + std::to_string(MAX_QUADRATIC_TERMS) + " terms";
+        return false;
+    } else if (status == QUADRATIC_NONE) {
+        result = "none";
+        return true;
+    }
+    bigint x_n;
+    bigint y_n;
+    pell_power(v[0], x, y, v[1] == -1 ? 2 * v[2] - 1 : v[2], x_n, y_n);
+    result = bigint_to_string(x_n) + " " + bigint_to_string(y_n);
+    return true;
+}
+
+
+// Job: 'cfarith op P1 D1 Q1 P2 D2 Q2 n' gives the first n terms of x op y for
+// x = (P1 + sqrt(D1)) / Q1 and y = (P2 + sqrt(D2)) / Q2, where op is +, -, *
+// or /.
+bool job_cfarith(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    str op;
+    str operands;
+    split_job(args, op, operands);
+    cf_source x;
+    cf_source y;
+    gosper_state state;
+    if (!parse_exact(operands, 7, v, result)) {
+        return false;
+    } else if (!init_cf_source(x, v[0], v[1], v[2])
+    || !init_cf_source(y, v[3], v[4], v[5])) {
+        result = "Q must not be 0, D negative, or the numbers over 10^18";
+        return false;
+    } else if (op.size() != 1 || !init_gosper(state, op[0], x, y)) {
+        result = "op must be +, -, * or /";
+        return false;
+    } else if (v[6] <= 0 || v[6] > MAX_CF_TERMS) {
+        result = "n must be 1 to " + std::to_string(MAX_CF_TERMS);
+        return false;
+    }
+
+    bigint term;
+    int status = next_gosper_term(state, term);
+    result = "[";
+    for (int index = 0; index < v[6] && status == GOSPER_TERM; ++index) {
+        result += index == 0 ? "" : index == 1 ? "; " : ", ";
+        result += bigint_to_string(term);
+        status = next_gosper_term(state, term);
+    }
+    result += status == GOSPER_TERM ? ", ...]" : "]";
+
+    if (status == GOSPER_UNDEFINED) {
+        result = "division by zero";
+        return false;
+    } else if (status == GOSPER_UNDECIDED) {
+        result = "term " + std::to_string(state.emitted) + " cannot be "
+        "decided, the result is probably rational";
+        return false;
+    }
+    return true;
+}
+
+
+// Job: 'lde a b c' gives 'x0 xk y0 yk' where x = x0 + xk * k and
+// y = y0 - yk * k solve ax + by = c.
+bool job_lde(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 3, v, result)) {
+        return false;
+    } else if (v[0] <= 0 || v[1] <= 0) {
+        result = "coefficients must be positive";
+        return false;
+    }
+
+    lde_solution solution;
+    if (!solve_lde(v[0], v[1], v[2], solution)) {
+        result = "no solution";
+        return true;
+    }
+    result = std::to_string(solution.x0) + " " + std::to_string(solution.xk)
+    + " " + std::to_string(solution.y0) + " " + std::to_string(solution.yk);
+    return true;
+}
+
+
+// Job: 'ldebox a b c x1 x2 y1 y2' gives 'n x y x' y'', the number of solutions
+// of ax + by = c with x1 <= x <= x2 and y1 <= y <= y2, then the solutions with
+// the smallest and largest x, or '0'.
+bool job_ldebox(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 7, v, result)) {
+        return false;
+    } else if (v[0] <= 0 || v[1] <= 0) {
+        result = "coefficients must be positive";
+        return false;
+    }
+
+    lde_solution solution;
+    lde_box box = {v[3], v[4], v[5], v[6]};
+    int128 k_first;
+    int128 k_last;
+    if (!solve_lde(v[0], v[1], v[2], solution)) {
+        result = "0";
+        return true;
+    }
+    uint128 count = lde_k_range(solution, box, k_first, k_last);
+    result = bigint_to_string(bigint_from_uint128(count));
+    if (count == 0) {
+        return true;
+    }
+
+    // Solutions in the box fit in 64 bits.
+    int128 ends[2] = {k_first, k_last};
+    for (size_t index = 0; index < 2; ++index) {
+        result += " " + std::to_string((long long)(solution.x0
+        + solution.xk * ends[index])) + " " + std::to_string(
+        (long long)(solution.y0 - solution.yk * ends[index]));
+    }
+    return true;
+}
+
+
+// Job: 'ldesys m n A b' solves the m equations A x = b in n variables, with A
+// given row by row. Gives 'x | v1 | v2 ...', where every solution is x plus
+// an integer combination of the v_i, or 'none'.
+bool job_ldesys(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_ints(args, v) || v.size() < 2) {
+        result = "expected m, n, then the coefficients and constants";
+        return false;
+    } else if (v[0] <= 0 || v[1] <= 0 || v[0] > MAX_SYSTEM_SIZE
+    || v[1] > MAX_SYSTEM_SIZE) {
+        result = "m and n must be 1 to " + std::to_string(MAX_SYSTEM_SIZE);
+        return false;
+    } else if ((int)(v.size()) != 2 + v[0] * (v[1] + 1)) {
+        result = "expected " + std::to_string(v[0] * (v[1] + 1))
+        + " coefficients and constants";
+        return false;
+    }
+
+    // The coefficients come first, then the constants.
+    big_matrix A(v[0], big_vec(v[1]));
+    big_vec b(v[0]);
+    for (int row = 0; row < v[0]; ++row) {
+        for (int column = 0; column < v[1]; ++column) {
+            A[row][column] = bigint_from_int(v[2 + row * v[1] + column]);
+        }
+        b[row] = bigint_from_int(v[2 + v[0] * v[1] + row]);
+    }
+
+    big_vec particular;
+    big_matrix basis;
+    if (!solve_lde_system(A, b, particular, basis)) {
+        result = "none";
+        return true;
+    }
+    result.clear();
+    for (size_t index = 0; index < particular.size(); ++index) {
+        result += (index ? " " : "") + bigint_to_string(particular[index]);
+    }
+    for (const big_vec &generator : basis) {
+        result += " |";
+        for (const bigint &entry : generator) {
+            result += " " + bigint_to_string(entry);
+        }
+    }
+    return true;
+}
+
+
+// Job: 'crt a1 b1 m1 a2 b2 m2 ...' gives 'x m' solving every a_i x = b_i
+// (mod m_i).
+bool job_crt(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_ints(args, v) || v.empty() || v.size() % 3 != 0) {
+        result = "expected triples a b m";
+        return false;
+    }
+
+    // Reuse the EEA buffers for the coefficients, constants and moduli.
+    buffers.q.clear();
+    buffers.r.clear();
+    buffers.x.clear();
+    for (size_t index = 0; index < v.size(); index += 3) {
+        buffers.q.push_back(v[index]);
+        buffers.r.push_back(v[index + 1]);
+        buffers.x.push_back(v[index + 2]);
+    }
+
+    // The same solver as crt-batch, so large LCMs fall back to big integers.
+    solve_system_line(buffers.q, buffers.r, buffers.x, result);
+    return true;
+}
+
+
+// Job: 'powmod b e m' gives b^e mod m.
+bool job_powmod(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 3, v, result)) {
+        return false;
+    } else if (v[1] < 0) {
+        result = "exponent must be non-negative";
+        return false;
+    } else if (v[2] <= 0) {
+        result = "modulus must be positive";
+        return false;
+    }
+
+    result = std::to_string(mod_pow(v[0], v[1], v[2]));
+    return true;
+}
+
+
+// Job: 'dlog b a m' gives the smallest x with b^x = a (mod m), or 'none'.
+bool job_dlog(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 3, v, result)) {
+        return false;
+    } else if (v[2] <= 0) {
+        result = "modulus must be positive";
+        return false;
+    }
+
+    int x;
+    int period;
+    int status = discrete_log(v[0], v[1], v[2], x, period);
+    if (status == DLOG_TOO_LARGE) {
+        result = "order has a prime factor above "
+        + std::to_string(MAX_DLOG_PRIME);
+        return false;
+    }
+    result = status == DLOG_SOLVED ? std::to_string(x) : "none";
+    return true;
+}
+
+
+// Job: 'sieve n' gives the primes up to and including n, for n at most
+// LARGE_INPUT_SIZE.
+bool job_sieve(const str &args, job_buffers &buffers, str &result) {
+    int_vec &v = buffers.values;
+    if (!parse_exact(args, 1, v, result)) {
+        return false;
+    } else if (v[0] <= 1) {
+        result = "input too small";
+        return false;
+    } else if (v[0] > LARGE_INPUT_SIZE) {
+        // Larger sieves would not fit in memory alongside the other jobs.
+        result = "n must be at most " + std::to_string(LARGE_INPUT_SIZE);
+        return false;
+    }
+
+    // Answer from the cache, which only sieves for new, larger limits.
+    size_t count = cached_prime_count(buffers.primes, v[0]);
+    result.clear();
+    for (size_t index = 0; index < count; ++index) {
+        if (index) {
+            result += ' ';
+        }
+        result += std::to_string(buffers.primes.primes[index]);
+    }
+    return true;
+}
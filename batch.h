@@ -0,0 +1,180 @@
+/*
+Header file for the command line interface and batch mode, which run the
+algorithms without menus, prompts or banners.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#ifndef BATCH_H
+#define BATCH_H
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "base_conversion.h"
+#include "buffered_io.h"
+#include "continued_fractions.h"
+#include "crt.h"
+#include "debug.h"
+#include "discrete_log.h"
+#include "euclidean.h"
+#include "linear_diophantine.h"
+#include "server.h"
+#include "sieve.h"
+#include "thread_pool.h"
+
+
+#define BATCH_FLAG "--batch"
+#define HELP_FLAG  "--help"
+#define SERVE_COMMAND "serve"
+#define THREADS_FLAG "--threads"
+
+#define BATCH_WINDOW      16384 // Lines in flight at once in a batch.
+#define MAX_BATCH_THREADS 1024
+
+
+// Storage reused from one job to the next, so that jobs do not allocate once
+// the buffers have grown to fit them. Caches stay warm for as long as the
+// buffers live.
+typedef struct job_buffers {
+    str command;
+    str args;
+    int_vec values;
+    int_vec q;
+    int_vec r;
+    int_vec x;
+    int_vec y;
+    prime_cache primes;
+} job_buffers;
+
+
+// Runs the program from command line arguments. Returns the exit status.
+int run_command_line(int32_t argc, char **argv);
+
+
+// Prints how to use the command line interface.
+void print_usage(void);
+
+
+// Runs the interactive version of a command. Returns the exit status.
+int run_interactive_command(const str &command);
+
+
+// Reads one job per line from input and writes one result per line to output,
+// in the same order. If command is empty, each line starts with its own
+// command. Jobs run on the given number of threads. Returns the exit status.
+int run_batch(const str &command, std::istream &input, std::ostream &output,
+size_t threads);
+
+
+// Sets up empty buffers and caches for running jobs.
+void init_job_buffers(job_buffers &buffers);
+
+
+// Runs the job on a line holding a command and its arguments, and sets
+// response to the line to send back, which starts with 'error: ' on failure.
+void answer_job_line(const str &line, job_buffers &buffers, str &response);
+
+
+// Splits a job line into its command and the rest of the line.
+void split_job(const str &line, str &command, str &args);
+
+
+// Runs a single job. Returns false with an error message in result if the job
+// could not be run.
+bool run_job(const str &command, const str &args, job_buffers &buffers,
+str &result);
+
+
+// Reads whitespace-separated integers from args into values. Returns false if
+// any token is not an integer.
+bool parse_ints(const str &args, int_vec &values);
+
+
+// Job: 'gcd a b' gives the GCD of a and b.
+bool job_gcd(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'eea a b' gives 'g x y' where g = xa + yb.
+bool job_eea(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'base n b1 b2' converts n from base b1 to base b2.
+bool job_base(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'frac n d b' converts n / d to base b.
+bool job_frac(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'digits n d b k len' gives the fractional digits of n / d in base b at
+// positions k to k + len - 1, where 0 is the first digit after the point.
+bool job_digits(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'cf n d' gives the continued fraction of n / d.
+bool job_cf(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'convergents n d' gives the convergents of n / d.
+bool job_convergents(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'best n d N' gives the closest p/q to n / d with q at most N.
+bool job_best(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'qcf P D Q' gives the periodic continued fraction of (P + sqrt(D)) / Q.
+bool job_qcf(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'pell D s n' gives 'x y', the nth positive solution of x^2 - Dy^2 = s
+// for s = 1 or -1, or 'none'.
+bool job_pell(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'cfarith op P1 D1 Q1 P2 D2 Q2 n' gives the first n terms of x op y for
+// x = (P1 + sqrt(D1)) / Q1 and y = (P2 + sqrt(D2)) / Q2, where op is +, -, *
+// or /.
+bool job_cfarith(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'lde a b c' gives 'x0 xk y0 yk' where x = x0 + xk * k and
+// y = y0 - yk * k solve ax + by = c, with 0 <= x0 < xk.
+bool job_lde(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'ldebox a b c x1 x2 y1 y2' gives 'n x y x' y'', the number of solutions
+// of ax + by = c with x1 <= x <= x2 and y1 <= y <= y2, then the solutions with
+// the smallest and largest x, or '0'.
+bool job_ldebox(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'ldesys m n A b' solves the m equations A x = b in n variables, with A
+// given row by row. Gives 'x | v1 | v2 ...', where every solution is x plus
+// an integer combination of the v_i, or 'none'.
+bool job_ldesys(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'crt a1 b1 m1 a2 b2 m2 ...' gives 'x m' solving every a_i x = b_i
+// (mod m_i).
+bool job_crt(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'powmod b e m' gives b^e mod m.
+bool job_powmod(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'dlog b a m' gives the smallest x with b^x = a (mod m), or 'none'.
+bool job_dlog(const str &args, job_buffers &buffers, str &result);
+
+
+// Job: 'sieve n' gives the primes up to and including n, for n at most
+// LARGE_INPUT_SIZE.
+bool job_sieve(const str &args, job_buffers &buffers, str &result);
+
+
+#endif
@@ -2,7 +2,7 @@
 Implementation of benchmark functions.
 
 Written by Stephen Chuang.
-Last upated 25 August 2022.
+Last upated 18 October 2026.
 */
 
 
@@ -11,7 +11,13 @@ Last upated 25 August 2022.
 
 
 // The main code that runs the benchmark.
-int32_t main(void) {
+int32_t main(int32_t argc, char **argv) {
+    // Throughput reports can be run on their own without the scored run.
+    if (argc > 1 && str(argv[1]) == THROUGHPUT_FLAG) {
+        run_throughput_benchmarks();
+        return 0;
+    }
+
     // Generate input for benchmark. Print I/O speed of program as well.
     print_benchmark_info();
 
@@ -135,6 +141,8 @@ int32_t main(void) {
     show_benchmark_result(time);
     input.close();
 
+    // These are reported separately and do not affect the score.
+    run_throughput_benchmarks();
     return 0;
 }
 
@@ -269,9 +277,9 @@ void benchmark_int_base(str input, int old_base, int new_base) {
     // Convert input to individual digits.
     int decimal_val = to_decimal(digits, old_base);
     
-    // Convert decimal number to new base.
-    int_vec result_v = dec_to_base_digits(decimal_val, new_base);
-    str result = digits_to_str(result_v, new_base);
+    // Write the number in the new base, as do_integer_base_conversion() does.
+    char buffer[MAX_DIGITS_64];
+    write_in_base(decimal_val, new_base, buffer, MAX_DIGITS_64);
 
     return;
 }
@@ -279,49 +287,16 @@ void benchmark_int_base(str input, int old_base, int new_base) {
 
 // Benchmark function for fraction base conversion.
 void benchmark_frac_base(int original_num, int denominator, int new_base) {
-    // Calculate the integer part and set numerator to numerator of fractional
-    // part only.
-    int int_part = original_num / denominator;
-    int numerator = original_num % denominator;
-
     // Perform base conversion on integer part.
+    int int_part = original_num / denominator;
     str converted_int = auto_dec_int_conversion(int_part, new_base);
 
-    // Vectors to store the integer and fractional parts after multiplying by
-    // the base.
-    int_vec num;
-    int_vec den;
-    int_vec integer_parts;
-    num.reserve(MAX_ITERATIONS);
-    den.reserve(MAX_ITERATIONS);
-    integer_parts.reserve(MAX_ITERATIONS);
-
-    // Perform first iteration.
-    int product = numerator * new_base;
-    num.push_back(product % denominator);
-    den.push_back(denominator);
-    integer_parts.push_back(product / denominator);
-
-    // Finish the rest of the base conversion.
-    int conv_product;
-    int new_numer;
-    int new_denom;
-    
-    // MAX_ITERATIONS prevents infinite looping.
-    while (num.size() < MAX_ITERATIONS && num[num.size() - 1]) {
-        // Multiply numerator by the base.
-        conv_product = num[num.size() - 1] * new_base;
-        new_numer = product % den[den.size() - 1];
-        new_denom = den[den.size() - 1]; // Same as previous denominator.
-        int new_integer_part = conv_product / new_denom;
-
-        num.push_back(new_numer);
-        den.push_back(new_denom); // Same as previous denominator.
-        integer_parts.push_back(new_integer_part);
-    }
-
-    // Search for cycles. If a cycle is found, the expansion is periodic.
-    find_repeat(num);
+    // Find the preperiod and period in closed form, then stream their digits,
+    // as do_fraction_base_conversion() does, into a stream that discards them.
+    frac_expansion expansion = analyse_fraction(original_num, denominator,
+    new_base);
+    std::ostream discard(nullptr);
+    stream_fraction(expansion, discard);
 
     return;
 }
@@ -329,28 +304,14 @@ void benchmark_frac_base(int original_num, int denominator, int new_base) {
 
 // Benchmark function for continued fraction convergents.
 void benchmark_convergents(int numerator, int denominator) {
-    // Vectors to be used in converting to continued fraction and calculating
-    // convergents and error bounds.
-    int_v q;
-    int_v r;
-    int_v x;
-    int_v y;
-
-    // Convert to continued fraction using extended Euclidean algorithm.
-    auto_silent_eea(q, r, x, y, numerator, denominator);
-
-    // Calculate convergents silently. Use of index here refers to the index in
-    // vector q.
-    for (size_t index = 0; index < q.size(); ++index) {
-        // Terminate program if necessary to prevent integer overflow.
-        if (x[index + 2] > MAX_INPUT || y[index + 2] > MAX_INPUT) {
-            return;
-        }
-
-        // Check that index is valid before calculating error bound.
-        if ((index + 1) >= q.size() || (index + 2) >= x.size()) {
-            return;
-        }
+    // Generate every convergent and error bound silently. Nothing is stored,
+    // so each term costs one division.
+    if (numerator < 0 || denominator <= 0) {
+        return;
+    }
+    convergent_stream stream;
+    init_convergent_stream(stream, numerator, denominator);
+    while (next_convergent(stream)) {
     }
 
     return;
@@ -359,27 +320,12 @@ void benchmark_convergents(int numerator, int denominator) {
 
 // Benchmark function for linear Diophantine solver.
 void benchmark_diophantine(int x_coeff, int y_coeff, int constant) {
-    // Perform extended Euclidean algorithm.
-    int_v q;
-    int_v r;
-    int_v x;
-    int_v y;
-    auto_silent_eea(q, r, x, y, x_coeff, y_coeff);
-
-    // Solve the Diophantine equation using the output from the extended
-    // Euclidean algorithm. GCD is second last element of remainders.
-    int gcd = r[r.size() - 2];
-
-    // Error checking - ensure that constant divides the gcd of x and y 
-    // coefficients.
-    if (constant % gcd != 0) {
-        return;
+    // Solve the Diophantine equation silently, without allocating.
+    lde_solution solution;
+    if (x_coeff > 0 && y_coeff > 0) {
+        solve_lde(x_coeff, y_coeff, constant, solution);
     }
 
-    // Convert k coefficients to absolute values.
-    int xk = abs(xk);
-    int yk = abs(yk);
-
     return;
 }
 
@@ -407,3 +353,452 @@ void show_benchmark_result(int time) {
     std::cout << "\nBenchmark took " << time << " microseconds.\n";
     std::cout << "Your score is " << score << ".\n\n"; 
 }
+
+
+// Runs throughput reports that are not part of the score.
+void run_throughput_benchmarks(void) {
+    std::cout << "Throughput reports (not included in the score):\n\n";
+
+    size_t threads = std::thread::hardware_concurrency();
+    std::cout << "Product tree CRT with " << threads << " threads:\n";
+    benchmark_crt_tree(10);
+    benchmark_crt_tree(1000);
+    benchmark_crt_tree(100000);
+    std::cout << "\n";
+
+    std::cout << "Integer parsing in to_decimal():\n";
+    benchmark_to_decimal("ZZZZZZZZZZZZ", 36);
+    benchmark_decode_digits(DECIMAL);
+    benchmark_decode_digits(36);
+    std::cout << "\n";
+
+    std::cout << "Arbitrary-length integer base conversion:\n";
+    benchmark_big_base(10000);
+    benchmark_big_base(100000);
+    benchmark_big_base(300000);
+    benchmark_regroup(HEXADECIMAL, BINARY);
+    benchmark_regroup(BINARY, HEXADECIMAL);
+    benchmark_regroup(OCTAL, 32);
+    std::cout << "\n";
+
+    std::cout << "Best approximation with bounded denominator:\n";
+    benchmark_best_approximation(1000);
+    benchmark_best_approximation(1000000000);
+    std::cout << "\n";
+
+    std::cout << "Batch linear Diophantine solver:\n";
+    benchmark_lde_stream(1000000000);
+    benchmark_lde_stream(MAX_INT_64);
+    std::cout << "\n";
+
+    std::cout << "Modular exponentiation:\n";
+    benchmark_mod_pow(MAX_INT_64 + 1);
+    benchmark_mod_pow(MAX_INT_64);
+    std::cout << "\n";
+
+    std::cout << "Discrete logarithm:\n";
+    benchmark_discrete_log(DLOG_SMOOTH_PRIME);
+    benchmark_discrete_log(DLOG_ROUGH_PRIME);
+    std::cout << "\n";
+
+    // Scaling of batch mode on mixed jobs, doubling the threads each time.
+    std::cout << "Mixed batch of " << BATCH_BENCH_JOBS << " jobs:\n";
+    str jobs = generate_mixed_jobs(BATCH_BENCH_JOBS);
+    double single_rate = benchmark_batch_scaling(jobs, 1, 0);
+    for (size_t count = 2; count < 2 * threads; count *= 2) {
+        benchmark_batch_scaling(jobs, std::min(count, threads), single_rate);
+    }
+    std::cout << "\n";
+    return;
+}
+
+
+// Reports how many congruences per second the product tree CRT solves for
+// systems of the given size.
+void benchmark_crt_tree(int congruence_count) {
+    // Use the first primes as moduli, with residues spread over each modulus.
+    int_vec primes = eratosthenes(CRT_TREE_PRIME_MAX);
+    int_vec moduli(primes.begin(), primes.begin() + congruence_count);
+    int_vec constants;
+    for (int i = 0; i < congruence_count; ++i) {
+        constants.push_back((i * 7919 + 13) % moduli[i]);
+    }
+
+    // Repeat small systems so every report does a similar amount of work.
+    int repeats = std::max(CRT_TREE_WORK / congruence_count, 1LL);
+    size_t threads = std::thread::hardware_concurrency();
+    bigint solution;
+    bigint product;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        crt_product_tree(constants, moduli, solution, product, threads);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    // Spot check the last solution against a sample of the congruences.
+    int step = std::max(congruence_count / 100, 1LL);
+    for (int i = 0; i < congruence_count; i += step) {
+        int residue = bigint_mod_uint(solution, moduli[i]);
+        if (residue != constants[i]) {
+            std::cerr << RED << "Error: product tree CRT gave a wrong answer.";
+            std::cerr << RESET << "\n";
+            return;
+        }
+    }
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    std::cout << "  k = " << std::setw(6) << congruence_count << ": ";
+    int rate = repeats * congruence_count / seconds;
+    std::cout << rate;
+    std::cout << " congruences/s (" << time / repeats << " us per system)\n";
+    return;
+}
+
+
+// The old to_decimal(), which adds up each digit times a floating point power
+// of the base. Kept to compare against.
+static int pow_to_decimal(int_vec digits, int base) {
+    int result = 0;
+    int power = 0;
+    while (digits.size()) {
+        int new_digit = digits[digits.size() - 1];
+        digits.pop_back();
+        result += new_digit * pow(base, power);
+        ++power;
+    }
+    return result;
+}
+
+
+// Compares to_decimal() with the old floating point version on the integer
+// base conversion input, and checks both on a value doubles cannot hold.
+void benchmark_to_decimal(str input, int base) {
+    int_vec digits;
+    check_string(input, base, digits);
+
+    // Sum the results so the loops cannot be optimised away.
+    volatile int checksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < TO_DECIMAL_ITER; ++i) {
+        checksum += pow_to_decimal(digits, base);
+    }
+    auto middle = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < TO_DECIMAL_ITER; ++i) {
+        checksum -= to_decimal(digits, base);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int old_time = std::chrono::duration_cast<std::chrono::nanoseconds>(middle - start).count();
+    int new_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - middle).count();
+
+    int_vec inexact;
+    check_string(INEXACT_INPUT, DECIMAL, inexact);
+    std::cout << "  pow():  " << old_time / TO_DECIMAL_ITER << " ns per call, ";
+    std::cout << INEXACT_INPUT << " -> " << pow_to_decimal(inexact, DECIMAL);
+    std::cout << "\n  Horner: " << new_time / TO_DECIMAL_ITER << " ns per call, ";
+    std::cout << INEXACT_INPUT << " -> " << to_decimal(inexact, DECIMAL) << "\n";
+    return;
+}
+
+
+// Reports how many characters per second decode_digits() validates and
+// decodes, for a long string of digits in the given base.
+void benchmark_decode_digits(int base) {
+    str input;
+    for (int i = 0; i < DECODE_LENGTH; ++i) {
+        int digit = (i * 7 + 3) % base;
+        input += digit < 10 ? '0' + digit : 'a' + digit - 10;
+    }
+
+    int_vec digits;
+    size_t error_index;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < DECODE_ITER; ++i) {
+        digits.clear();
+        if (decode_digits(input, base, digits, error_index) != DIGITS_VALID) {
+            std::cerr << RED << "Error: valid digits were rejected." << RESET;
+            std::cerr << "\n";
+            return;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    std::cout << "  decode_digits(), base-" << base << ": ";
+    std::cout << (long long)(DECODE_LENGTH * DECODE_ITER / seconds / 1000000);
+    std::cout << " million chars/s\n";
+    return;
+}
+
+
+// Reports how many input characters per second regroup_pow2() converts
+// between two power-of-two bases.
+void benchmark_regroup(int old_base, int new_base) {
+    str input;
+    for (int i = 0; i < REGROUP_LENGTH; ++i) {
+        int digit = (i * 7 + 3) % old_base;
+        input += digit < 10 ? '0' + digit : 'A' + digit - 10;
+    }
+    input[0] = '1';
+
+    str output;
+    str round_trip;
+    auto start = std::chrono::high_resolution_clock::now();
+    regroup_pow2(input, old_base, new_base, output);
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    regroup_pow2(output, new_base, old_base, round_trip);
+    if (round_trip != input) {
+        std::cerr << RED << "Error: regrouping bits gave a wrong answer.";
+        std::cerr << RESET << "\n";
+        return;
+    }
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    std::cout << "  Regroup base-" << old_base << " to base-" << new_base;
+    std::cout << ": " << (long long)(REGROUP_LENGTH / seconds / 1000000);
+    std::cout << " million chars/s\n";
+    return;
+}
+
+
+// Reports how many best approximation queries per second are answered for
+// random fractions with denominators up to 10^18 and the given limit.
+void benchmark_best_approximation(int limit) {
+    // A fixed linear congruential generator, so every run does the same work.
+    uint64_t state = 12345;
+    int_vec numerators(BEST_APPROX_ITER);
+    int_vec denominators(BEST_APPROX_ITER);
+    for (int i = 0; i < BEST_APPROX_ITER; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        denominators[i] = (state >> 4) % 1000000000000000000LL + 1;
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        numerators[i] = (state >> 4) % denominators[i];
+    }
+
+    // Sum the results so the loop cannot be optimised away.
+    volatile int checksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BEST_APPROX_ITER; ++i) {
+        int p;
+        int q;
+        best_approximation(numerators[i], denominators[i], limit, p, q);
+        checksum += p + q;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    std::cout << "  Denominators up to " << limit << ": ";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << BEST_APPROX_ITER / seconds / 1000000 << " million queries/s\n";
+    std::cout << std::defaultfloat;
+    return;
+}
+
+
+// Reports how many equations per second solve_lde_stream() reads, solves and
+// writes, for random coefficients up to the given size.
+void benchmark_lde_stream(int max_coeff) {
+    // A fixed linear congruential generator, so every run does the same work.
+    uint64_t state = 12345;
+    std::stringstream equations;
+    for (int i = 0; i < LDE_STREAM_COUNT; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            equations << (int)((state >> 1) % max_coeff + 1) << (j < 2 ? ' '
+            : '\n');
+        }
+    }
+    std::ostringstream output;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    int count = solve_lde_stream(equations, output);
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    std::cout << "  Coefficients up to " << max_coeff << ": ";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << count / seconds / 1000000 << " million equations/s\n";
+    std::cout << std::defaultfloat;
+    return;
+}
+
+
+// Reports how many modular powers per second are taken with 63-bit
+// exponents modulo m, one at a time and through batch_mod_pow().
+void benchmark_mod_pow(int m) {
+    // A fixed linear congruential generator, so every run does the same work.
+    uint64_t state = 12345;
+    u64_vec exponents(MOD_POW_ITER);
+    for (uint64_t &exponent : exponents) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        exponent = state >> 1;
+    }
+
+    mod_context context;
+    init_mod_context(context, m);
+    uint64_t base = to_mod_form(context, 3);
+
+    // Sum the results so the loop cannot be optimised away.
+    volatile uint64_t checksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint64_t exponent : exponents) {
+        checksum += mod_pow(context, base, exponent);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int single_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    u64_vec results;
+    start = std::chrono::high_resolution_clock::now();
+    batch_mod_pow(context, 3, exponents, results);
+    end = std::chrono::high_resolution_clock::now();
+    int batch_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    double single_seconds = std::max(single_time, 1LL) / 1000000.0;
+    double batch_seconds = std::max(batch_time, 1LL) / 1000000.0;
+    std::cout << "  Modulus " << m << (m % 2 ? " (Montgomery): "
+    : " (Barrett): ");
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << MOD_POW_ITER / single_seconds / 1000000 << " million powers/s";
+    std::cout << ", " << MOD_POW_ITER / batch_seconds / 1000000;
+    std::cout << " million in a batch\n";
+    std::cout << std::defaultfloat;
+    return;
+}
+
+
+// Reports how many discrete logarithms base 3 per second are found modulo the
+// prime m, for random targets.
+void benchmark_discrete_log(int m) {
+    // A fixed linear congruential generator, so every run does the same work.
+    uint64_t state = 12345;
+    int_vec targets(DLOG_ITER);
+    for (int &target : targets) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        target = mod_pow(3, state >> 1, m);
+    }
+
+    int solved = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int target : targets) {
+        int x;
+        int period;
+        solved += discrete_log(3, target, m, x, period) == DLOG_SOLVED;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    if (solved != DLOG_ITER) {
+        std::cerr << RED << "Error: discrete logarithm gave a wrong answer.";
+        std::cerr << RESET << "\n";
+        return;
+    }
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    std::cout << "  Modulus " << m << ": ";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << DLOG_ITER / seconds << " logarithms/s (";
+    std::cout << time / DLOG_ITER << " us each)\n";
+    std::cout << std::defaultfloat;
+    return;
+}
+
+
+// Reports how many digits per second arbitrary-length integer base conversion
+// handles, converting a decimal integer with the given number of digits to
+// base-36 and back.
+void benchmark_big_base(int digit_count) {
+    int_vec digits;
+    for (int i = 0; i < digit_count; ++i) {
+        digits.push_back((i * 7 + 3) % 10);
+    }
+    digits[0] = 1;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    int_vec converted = convert_digits(digits, DECIMAL, 36);
+    std::reverse(converted.begin(), converted.end());
+    int_vec round_trip = convert_digits(converted, 36, DECIMAL);
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::reverse(round_trip.begin(), round_trip.end());
+    if (round_trip != digits) {
+        std::cerr << RED << "Error: base conversion gave a wrong answer.";
+        std::cerr << RESET << "\n";
+        return;
+    }
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    std::cout << "  " << std::setw(7) << digit_count << " digits: ";
+    std::cout << (long long)(2 * digit_count / seconds) << " digits/s (";
+    std::cout << time / 1000 << " ms there and back)\n";
+    return;
+}
+
+
+// Generates a batch of mixed jobs, from cheap GCDs up to long fraction
+// expansions, one 'command args' job per line.
+str generate_mixed_jobs(int count) {
+    // A fixed linear congruential generator keeps every run identical.
+    unsigned long long state = 2400;
+    auto next = [&](unsigned long long limit) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (long long)((state >> 16) % limit);
+    };
+
+    str jobs;
+    for (int i = 0; i < count; ++i) {
+        int kind = next(100);
+        if (kind < 30) {
+            jobs += "gcd " + std::to_string(next(MAX_INT_64) + 1) + " "
+            + std::to_string(next(MAX_INT_64) + 1);
+        } else if (kind < 50) {
+            jobs += "base " + std::to_string(next(MAX_INT) + 1) + " 10 "
+            + std::to_string(next(35) + 2);
+        } else if (kind < 70) {
+            jobs += "crt 1 " + std::to_string(next(7)) + " 7 1 "
+            + std::to_string(next(11)) + " 11 3 2 13";
+        } else if (kind < 85) {
+            jobs += "lde " + std::to_string(next(MAX_INT) + 1) + " "
+            + std::to_string(next(MAX_INT) + 1) + " "
+            + std::to_string(next(MAX_INT));
+        } else if (kind < 99) {
+            jobs += "frac " + std::to_string(next(1000) + 1) + " "
+            + std::to_string(next(1000) + 1000) + " 2";
+        } else {
+            // The rare expensive jobs, with periods of up to 10^5 digits.
+            jobs += "frac 1 " + std::to_string(next(50000) + 50000) + " 2";
+        }
+        jobs += "\n";
+    }
+    return jobs;
+}
+
+
+// Reports how many mixed batch jobs per second run on the given number of
+// threads, and the speedup over the one thread rate if given. Returns the rate.
+double benchmark_batch_scaling(const str &jobs, size_t threads,
+double single_rate) {
+    std::istringstream input(jobs);
+    std::ostringstream output;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    run_batch("", input, output, threads);
+    auto end = std::chrono::high_resolution_clock::now();
+    int time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    double seconds = std::max(time, 1LL) / 1000000.0;
+    double rate = BATCH_BENCH_JOBS / seconds;
+    single_rate = single_rate > 0 ? single_rate : rate;
+
+    std::cout << "  " << std::setw(3) << threads << " threads: ";
+    std::cout << (long long)(rate) << " jobs/s (" << std::fixed;
+    std::cout << std::setprecision(2) << rate / single_rate << "x)\n";
+    std::cout << std::defaultfloat;
+    return rate;
+}
@@ -2,7 +2,7 @@
 Header file for benchmark functions.
 
 Written by Stephen Chuang.
-Last upated 25 August 2022.
+Last upated 18 October 2026.
 */
 
 
@@ -26,13 +26,19 @@ Last upated 25 August 2022.
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 #include "base_conversion.h"
+#include "batch.h"
+#include "bigint.h"
 #include "continued_fractions.h"
+#include "crt.h"
 #include "debug.h"
+#include "discrete_log.h"
 #include "euclidean.h"
 #include "linear_diophantine.h"
+#include "modular.h"
 #include "sieve.h"
 #include "benchmark.h"
 
@@ -57,6 +63,22 @@ Last upated 25 August 2022.
 
 #define REFERENCE_TIME 77500000 // 77.5 seconds.
 
+#define THROUGHPUT_FLAG    "--throughput"
+#define CRT_TREE_WORK      100000 // Congruences solved per throughput report.
+#define CRT_TREE_PRIME_MAX 2000000
+#define BATCH_BENCH_JOBS   200000 // Jobs in the mixed batch scaling report.
+#define TO_DECIMAL_ITER    2000000  // 2 * 10^6
+#define INEXACT_INPUT      "9007199254740993" // 2^53 + 1 in decimal.
+#define DECODE_LENGTH      1000000  // Characters per digit decoding report.
+#define DECODE_ITER        100
+#define REGROUP_LENGTH     10000000 // Characters per regrouping report.
+#define BEST_APPROX_ITER   2000000  // Queries per best approximation report.
+#define LDE_STREAM_COUNT   2000000  // Equations per batch LDE report.
+#define MOD_POW_ITER       1000000  // Powers per modular exponentiation report.
+#define DLOG_ITER          200      // Logarithms per discrete logarithm report.
+#define DLOG_SMOOTH_PRIME  5860493803644113927 // p - 1 has factors below 2000.
+#define DLOG_ROUGH_PRIME   5371771371189382399 // p - 1 has a factor near 10^11.
+
 
 // Input generator for the benchmark.
 void generate_input(void);
@@ -110,4 +132,65 @@ void print_input_error_message(void);
 void show_benchmark_result(int time);
 
 
+// Runs throughput reports that are not part of the score.
+void run_throughput_benchmarks(void);
+
+
+// Reports how many congruences per second the product tree CRT solves for
+// systems of the given size.
+void benchmark_crt_tree(int congruence_count);
+
+
+// Compares to_decimal() with the old floating point version on the integer
+// base conversion input, and checks both on a value doubles cannot hold.
+void benchmark_to_decimal(str input, int base);
+
+
+// Reports how many characters per second decode_digits() validates and
+// decodes, for a long string of digits in the given base.
+void benchmark_decode_digits(int base);
+
+
+// Reports how many input characters per second regroup_pow2() converts
+// between two power-of-two bases.
+void benchmark_regroup(int old_base, int new_base);
+
+
+// Reports how many best approximation queries per second are answered for
+// random fractions with denominators up to 10^18 and the given limit.
+void benchmark_best_approximation(int limit);
+
+
+// Reports how many equations per second solve_lde_stream() reads, solves and
+// writes, for random coefficients up to the given size.
+void benchmark_lde_stream(int max_coeff);
+
+
+// Reports how many modular powers per second are taken with 63-bit
+// exponents modulo m, one at a time and through batch_mod_pow().
+void benchmark_mod_pow(int m);
+
+
+// Reports how many discrete logarithms base 3 per second are found modulo the
+// prime m, for random targets.
+void benchmark_discrete_log(int m);
+
+
+// Reports how many digits per second arbitrary-length integer base conversion
+// handles, converting a decimal integer with the given number of digits to
+// base-36 and back.
+void benchmark_big_base(int digit_count);
+
+
+// Generates a batch of mixed jobs, from cheap GCDs up to long fraction
+// expansions, one 'command args' job per line.
+str generate_mixed_jobs(int count);
+
+
+// Reports how many mixed batch jobs per second run on the given number of
+// threads, and the speedup over the one thread rate if given. Returns the rate.
+double benchmark_batch_scaling(const str &jobs, size_t threads,
+double single_rate);
+
+
 #endif
@@ -0,0 +1,846 @@
+/*
+Implementation of arbitrary-precision integer functions.
+
+Magnitudes are stored as vectors of 32-bit limbs. Multiplication switches from
+schoolbook to Karatsuba above KARATSUBA_THRESHOLD limbs, and division switches
+from Knuth's long division to Barrett reduction with a Newton reciprocal above
+BARRETT_THRESHOLD limbs, so that both run in subquadratic time.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#include "bigint.h"
+
+
+// Removes leading zero limbs.
+static void trim(limb_vec &v) {
+    while (v.size() && v[v.size() - 1] == 0) {
+        v.pop_back();
+    }
+    return;
+}
+
+
+// Compares two magnitudes. Returns -1, 0 or 1.
+static int mag_compare(const limb_vec &a, const limb_vec &b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+
+    for (size_t index = a.size(); index-- > 0;) {
+        if (a[index] != b[index]) {
+            return a[index] < b[index] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+
+// Adds b (nb limbs) into a (na >= nb limbs) in place. Returns the carry.
+static uint32_t add_into(uint32_t *a, size_t na, const uint32_t *b, size_t nb) {
+    uint64_t carry = 0;
+    size_t index = 0;
+    for (; index < nb; ++index) {
+        carry += uint64_t(a[index]) + b[index];
+        a[index] = uint32_t(carry);
+        carry >>= LIMB_BITS;
+    }
+
+    for (; carry && index < na; ++index) {
+        carry += a[index];
+        a[index] = uint32_t(carry);
+        carry >>= LIMB_BITS;
+    }
+
+    return uint32_t(carry);
+}
+
+
+// Subtracts b (nb limbs) from a (na >= nb limbs) in place. Returns the borrow.
+static uint32_t sub_into(uint32_t *a, size_t na, const uint32_t *b, size_t nb) {
+    uint64_t borrow = 0;
+    size_t index = 0;
+    for (; index < nb; ++index) {
+        uint64_t difference = uint64_t(a[index]) - b[index] - borrow;
+        a[index] = uint32_t(difference);
+        borrow = (difference >> LIMB_BITS) & 1;
+    }
+
+    for (; borrow && index < na; ++index) {
+        uint64_t difference = uint64_t(a[index]) - borrow;
+        a[index] = uint32_t(difference);
+        borrow = (difference >> LIMB_BITS) & 1;
+    }
+
+    return uint32_t(borrow);
+}
+
+
+// Returns a + b for magnitudes.
+static limb_vec mag_add(const limb_vec &a, const limb_vec &b) {
+    const limb_vec &longer = a.size() >= b.size() ? a : b;
+    const limb_vec &shorter = a.size() >= b.size() ? b : a;
+
+    limb_vec result = longer;
+    result.push_back(0);
+    add_into(result.data(), result.size(), shorter.data(), shorter.size());
+    trim(result);
+    return result;
+}
+
+
+// Returns a - b for magnitudes with a >= b.
+static limb_vec mag_sub(const limb_vec &a, const limb_vec &b) {
+    limb_vec result = a;
+    sub_into(result.data(), result.size(), b.data(), b.size());
+    trim(result);
+    return result;
+}
+
+
+// Adds one to a magnitude in place.
+static void mag_increment(limb_vec &a) {
+    for (size_t index = 0; index < a.size(); ++index) {
+        if (++a[index] != 0) {
+            return;
+        }
+    }
+    a.push_back(1);
+    return;
+}
+
+
+// Subtracts one from a non-zero magnitude in place.
+static void mag_decrement(limb_vec &a) {
+    for (size_t index = 0; index < a.size(); ++index) {
+        if (a[index]-- != 0) {
+            break;
+        }
+    }
+    trim(a);
+    return;
+}
+
+
+// Multiplies a magnitude by β^count, where β = 2^32.
+static limb_vec shift_limbs_left(const limb_vec &a, size_t count) {
+    if (a.empty()) {
+        return a;
+    }
+    limb_vec result(count, 0);
+    result.insert(result.end(), a.begin(), a.end());
+    return result;
+}
+
+
+// Divides a magnitude by β^count, discarding the remainder.
+static limb_vec shift_limbs_right(const limb_vec &a, size_t count) {
+    if (a.size() <= count) {
+        return limb_vec();
+    }
+    return limb_vec(a.begin() + count, a.end());
+}
+
+
+// Schoolbook multiplication. out must have na + nb zeroed limbs.
+static void mul_schoolbook(const uint32_t *a, size_t na, const uint32_t *b,
+size_t nb, uint32_t *out) {
+    for (size_t i = 0; i < na; ++i) {
+        uint64_t carry = 0;
+        uint64_t multiplier = a[i];
+        for (size_t j = 0; j < nb; ++j) {
+            carry += multiplier * b[j] + out[i + j];
+            out[i + j] = uint32_t(carry);
+            carry >>= LIMB_BITS;
+        }
+        out[i + nb] = uint32_t(carry);
+    }
+    return;
+}
+
+
+// Karatsuba multiplication of two n-limb numbers into 2n limbs of out.
+static void mul_karatsuba(const uint32_t *a, const uint32_t *b, size_t n,
+uint32_t *out) {
+    if (n < KARATSUBA_THRESHOLD) {
+        std::fill(out, out + 2 * n, 0);
+        mul_schoolbook(a, n, b, n, out);
+        return;
+    }
+
+    // Split a = a1 * β^low + a0 and b likewise. z0 and z2 go straight into
+    // the low and high halves of out.
+    size_t low = n / 2;
+    size_t high = n - low;
+    mul_karatsuba(a, b, low, out);
+    mul_karatsuba(a + low, b + low, high, out + 2 * low);
+
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2.
+    limb_vec sum_a(a + low, a + n);
+    limb_vec sum_b(b + low, b + n);
+    sum_a.push_back(0);
+    sum_b.push_back(0);
+    add_into(sum_a.data(), high + 1, a, low);
+    add_into(sum_b.data(), high + 1, b, low);
+
+    limb_vec middle(2 * (high + 1));
+    mul_karatsuba(sum_a.data(), sum_b.data(), high + 1, middle.data());
+    sub_into(middle.data(), middle.size(), out, 2 * low);
+    sub_into(middle.data(), middle.size(), out + 2 * low, 2 * high);
+    trim(middle);
+
+    add_into(out + low, 2 * n - low, middle.data(), middle.size());
+    return;
+}
+
+
+// Multiplies numbers of any length. out must have na + nb zeroed limbs.
+static void mul_general(const uint32_t *a, size_t na, const uint32_t *b,
+size_t nb, uint32_t *out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    if (nb < KARATSUBA_THRESHOLD) {
+        mul_schoolbook(a, na, b, nb, out);
+        return;
+    }
+
+    // Cut the longer operand into pieces the size of the shorter one.
+    limb_vec part(2 * nb);
+    for (size_t offset = 0; offset < na; offset += nb) {
+        size_t length = std::min(nb, na - offset);
+        if (length == nb) {
+            mul_karatsuba(a + offset, b, nb, part.data());
+        } else {
+            std::fill(part.begin(), part.end(), 0);
+            mul_general(b, nb, a + offset, length, part.data());
+        }
+        add_into(out + offset, na + nb - offset, part.data(), length + nb);
+    }
+
+    return;
+}
+
+
+// Returns a * b for magnitudes.
+static limb_vec mag_mul(const limb_vec &a, const limb_vec &b) {
+    if (a.empty() || b.empty()) {
+        return limb_vec();
+    }
+
+    limb_vec result(a.size() + b.size(), 0);
+    mul_general(a.data(), a.size(), b.data(), b.size(), result.data());
+    trim(result);
+    return result;
+}
+
+
+// Divides a magnitude by a small positive d in place and returns the
+// remainder.
+static uint32_t mag_divmod_small(limb_vec &a, uint32_t d) {
+    uint64_t remainder = 0;
+    for (size_t index = a.size(); index-- > 0;) {
+        uint64_t current = (remainder << LIMB_BITS) | a[index];
+        a[index] = uint32_t(current / d);
+        remainder = current % d;
+    }
+    trim(a);
+    return uint32_t(remainder);
+}
+
+
+// Knuth's algorithm D. Requires b to have at least two limbs and a >= b.
+static void mag_divmod_knuth(const limb_vec &a, const limb_vec &b, limb_vec &q,
+limb_vec &r) {
+    size_t n = b.size();
+    size_t m = a.size() - n;
+
+    // Normalise so that the top limb of the divisor has its top bit set.
+    unsigned shift = __builtin_clz(b[n - 1]);
+    limb_vec bn(n);
+    limb_vec an(a.size() + 1);
+    for (size_t i = n - 1; i > 0; --i) {
+        bn[i] = (b[i] << shift) | (shift ? b[i - 1] >> (LIMB_BITS - shift) : 0);
+    }
+    bn[0] = b[0] << shift;
+
+    an[a.size()] = shift ? a[a.size() - 1] >> (LIMB_BITS - shift) : 0;
+    for (size_t i = a.size() - 1; i > 0; --i) {
+        an[i] = (a[i] << shift) | (shift ? a[i - 1] >> (LIMB_BITS - shift) : 0);
+    }
+    an[0] = a[0] << shift;
+
+    const uint64_t base = uint64_t(1) << LIMB_BITS;
+    q.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0;) {
+        // Estimate the quotient digit from the top two limbs.
+        uint64_t top = (uint64_t(an[j + n]) << LIMB_BITS) | an[j + n - 1];
+        uint64_t q_hat = top / bn[n - 1];
+        uint64_t r_hat = top % bn[n - 1];
+        while (q_hat >= base
+        || q_hat * bn[n - 2] > ((r_hat << LIMB_BITS) | an[j + n - 2])) {
+            --q_hat;
+            r_hat += bn[n - 1];
+            if (r_hat >= base) {
+                break;
+            }
+        }
+
+        // Multiply and subtract.
+        int64_t borrow = 0;
+        int64_t t;
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t product = q_hat * bn[i];
+            t = int64_t(an[i + j]) - borrow - int64_t(product & 0xFFFFFFFF);
+            an[i + j] = uint32_t(t);
+            borrow = int64_t(product >> LIMB_BITS) - (t >> LIMB_BITS);
+        }
+        t = int64_t(an[j + n]) - borrow;
+        an[j + n] = uint32_t(t);
+
+        // Add back if the estimate was one too large.
+        q[j] = uint32_t(q_hat);
+        if (t < 0) {
+            --q[j];
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                carry += uint64_t(an[i + j]) + bn[i];
+                an[i + j] = uint32_t(carry);
+                carry >>= LIMB_BITS;
+            }
+            an[j + n] += uint32_t(carry);
+        }
+    }
+
+    // Undo the normalisation on the remainder.
+    r.assign(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        r[i] = (an[i] >> shift)
+        | (shift ? an[i + 1] << (LIMB_BITS - shift) : 0);
+    }
+
+    trim(q);
+    trim(r);
+    return;
+}
+
+
+// Returns an approximation of β^(2m) / b, within a few units, where b has m
+// limbs. Uses Newton iteration from the reciprocal of the top half of b.
+static limb_vec approx_reciprocal(const limb_vec &b) {
+    size_t m = b.size();
+    limb_vec power(2 * m + 1, 0);
+    power[2 * m] = 1;
+
+    if (m < BARRETT_THRESHOLD) {
+        limb_vec q;
+        limb_vec r;
+        mag_divmod_knuth(power, b, q, r);
+        return q;
+    }
+
+    // Start from x = x_high * β^(m - high). The two guard limbs keep the error
+    // after one Newton step below a few units.
+    size_t high = m / 2 + 2;
+    limb_vec x_high = approx_reciprocal(limb_vec(b.end() - high, b.end()));
+
+    // One Newton step: x = x + x * (β^(2m) - b * x) / β^(2m). Only the top
+    // limbs of the error affect the result, so the rest are dropped.
+    limb_vec bx = shift_limbs_left(mag_mul(b, x_high), m - high);
+    bool below = mag_compare(bx, power) <= 0;
+    limb_vec error = below ? mag_sub(power, bx) : mag_sub(bx, power);
+    limb_vec step = mag_mul(x_high, shift_limbs_right(error, m - 2));
+    step = shift_limbs_right(step, high + 2);
+
+    limb_vec x = shift_limbs_left(x_high, m - high);
+    if (below) {
+        return mag_add(x, step);
+    }
+    return mag_compare(x, step) > 0 ? mag_sub(x, step) : limb_vec();
+}
+
+
+// Returns floor(β^(2m) / b) where b has m limbs.
+static limb_vec mag_reciprocal(const limb_vec &b) {
+    size_t m = b.size();
+    limb_vec power(2 * m + 1, 0);
+    power[2 * m] = 1;
+    limb_vec x = approx_reciprocal(b);
+
+    // Fix up the last few units so that 0 <= β^(2m) - b * x < b.
+    limb_vec bx = mag_mul(b, x);
+    while (mag_compare(bx, power) > 0) {
+        bx = mag_sub(bx, b);
+        mag_decrement(x);
+    }
+    limb_vec remainder = mag_sub(power, bx);
+    while (mag_compare(remainder, b) >= 0) {
+        remainder = mag_sub(remainder, b);
+        mag_increment(x);
+    }
+
+    return x;
+}
+
+
+// Barrett reduction of t < β^(2m) by the m-limb b, given x = floor(β^(2m) / b).
+static void barrett_step(const limb_vec &t, const limb_vec &b,
+const limb_vec &x, limb_vec &q, limb_vec &r) {
+    size_t m = b.size();
+    q = shift_limbs_right(mag_mul(shift_limbs_right(t, m - 1), x), m + 1);
+    r = mag_sub(t, mag_mul(q, b));
+
+    // The estimate is at most two too small.
+    while (mag_compare(r, b) >= 0) {
+        r = mag_sub(r, b);
+        mag_increment(q);
+    }
+    return;
+}
+
+
+// Divides a by b one m-limb block at a time using Barrett reduction, given
+// x = floor(β^(2m) / b).
+static void barrett_divide(const limb_vec &a, const limb_vec &b,
+const limb_vec &x, limb_vec &q, limb_vec &r) {
+    size_t m = b.size();
+    size_t blocks = (a.size() + m - 1) / m;
+
+    q.assign(blocks * m, 0);
+    r.clear();
+    for (size_t block = blocks; block-- > 0;) {
+        // Bring down the next block after the running remainder.
+        size_t start = block * m;
+        size_t end = std::min(a.size(), start + m);
+        limb_vec t(a.begin() + start, a.begin() + end);
+        t.resize(m, 0);
+        t.insert(t.end(), r.begin(), r.end());
+        trim(t);
+
+        limb_vec block_q;
+        barrett_step(t, b, x, block_q, r);
+        std::copy(block_q.begin(), block_q.end(), q.begin() + start);
+    }
+
+    trim(q);
+    return;
+}
+
+
+// Divides a by b one m-limb block at a time using Barrett reduction.
+static void mag_divmod_barrett(const limb_vec &a, const limb_vec &b,
+limb_vec &q, limb_vec &r) {
+    barrett_divide(a, b, mag_reciprocal(b), q, r);
+    return;
+}
+
+
+// Divides magnitudes, picking the algorithm by size. b must be non-zero.
+static void mag_divmod(const limb_vec &a, const limb_vec &b, limb_vec &q,
+limb_vec &r) {
+    if (mag_compare(a, b) < 0) {
+        q.clear();
+        r = a;
+    } else if (b.size() == 1) {
+        q = a;
+        uint32_t remainder = mag_divmod_small(q, b[0]);
+        r.clear();
+        if (remainder) {
+            r.push_back(remainder);
+        }
+    } else if (b.size() >= BARRETT_THRESHOLD
+    && a.size() - b.size() >= BARRETT_THRESHOLD) {
+        mag_divmod_barrett(a, b, q, r);
+    } else {
+        mag_divmod_knuth(a, b, q, r);
+    }
+    return;
+}
+
+
+// Builds a big integer from a sign and magnitude, keeping zero non-negative.
+static bigint make_bigint(bool negative, const limb_vec &limbs) {
+    bigint result;
+    result.limbs = limbs;
+    trim(result.limbs);
+    result.negative = negative && result.limbs.size();
+    return result;
+}
+
+
+// Creates a big integer from a signed 64-bit integer.
+bigint bigint_from_int(long long value) {
+    unsigned long long magnitude = value < 0 ? 0 - (unsigned long long)(value)
+    : value;
+    bigint result = bigint_from_uint(magnitude);
+    result.negative = value < 0;
+    return result;
+}
+
+
+// Creates a big integer from an unsigned 64-bit integer.
+bigint bigint_from_uint(unsigned long long value) {
+    return bigint_from_uint128(value);
+}
+
+
+// Creates a big integer from an unsigned 128-bit integer.
+bigint bigint_from_uint128(uint128 value) {
+    bigint result;
+    result.negative = false;
+    while (value) {
+        result.limbs.push_back(uint32_t(value));
+        value >>= LIMB_BITS;
+    }
+    return result;
+}
+
+
+// Reads a decimal string with an optional leading sign. Returns false if the
+// string is not a valid integer.
+bool bigint_from_string(const str &input, bigint &result) {
+    size_t index = 0;
+    bool negative = false;
+    if (index < input.size() && (input[index] == '-' || input[index] == '+')) {
+        negative = input[index] == '-';
+        ++index;
+    }
+    if (index == input.size()) {
+        return false;
+    }
+
+    int_vec digits;
+    digits.reserve(input.size() - index);
+    for (; index < input.size(); ++index) {
+        if (input[index] < '0' || input[index] > '9') {
+            return false;
+        }
+        digits.push_back(input[index] - '0');
+    }
+
+    result = bigint_from_digits(digits, 10);
+    result.negative = negative && result.limbs.size();
+    return true;
+}
+
+
+// Returns the decimal representation of a big integer.
+str bigint_to_string(const bigint &a) {
+    int_vec digits;
+    bigint_to_digits(a, 10, digits);
+
+    str result = a.negative ? "-" : "";
+    result.reserve(result.size() + digits.size());
+    for (size_t index = digits.size(); index-- > 0;) {
+        result += '0' + digits[index];
+    }
+    return result;
+}
+
+
+// Powers of a base used to split numbers for radix conversion.
+typedef struct radix_powers {
+    uint32_t base;
+    uint32_t chunk_value;     // The largest power of base that fits a limb.
+    size_t chunk_digits;      // So that chunk_value = base^chunk_digits.
+    std::vector<bigint> powers;        // powers[k] = chunk_value^(2^k).
+    std::vector<limb_vec> reciprocals; // For Barrett division, if large.
+} radix_powers;
+
+
+// Finds the largest power of base that fits in a limb.
+static void radix_chunk(uint32_t base, radix_powers &radix) {
+    radix.base = base;
+    radix.chunk_value = 1;
+    radix.chunk_digits = 0;
+    while (uint64_t(radix.chunk_value) * base <= UINT32_MAX) {
+        radix.chunk_value *= base;
+        ++radix.chunk_digits;
+    }
+    return;
+}
+
+
+// Creates a big integer from its digits in a base from 2 to 36, most
+// significant first. Digits must be less than the base.
+bigint bigint_from_digits(const int_vec &digits, int base) {
+    radix_powers radix;
+    radix_chunk(base, radix);
+
+    // Read one limb's worth of digits at a time, least significant first.
+    std::vector<bigint> level;
+    level.reserve(digits.size() / radix.chunk_digits + 1);
+    size_t end = digits.size();
+    while (end > 0) {
+        size_t start = end > radix.chunk_digits ? end - radix.chunk_digits : 0;
+        uint32_t value = 0;
+        for (size_t index = start; index < end; ++index) {
+            value = value * base + digits[index];
+        }
+        level.push_back(bigint_from_uint(value));
+        end = start;
+    }
+
+    // Combine neighbours as low + high * power, where power is the base to
+    // the number of digits in low, squaring the power at each level. Every
+    // level multiplies numbers of equal size, so this takes O(M(n) log n).
+    bigint power = bigint_from_uint(radix.chunk_value);
+    while (level.size() > 1) {
+        size_t pairs = level.size() / 2;
+        for (size_t index = 0; index < pairs; ++index) {
+            level[index] = bigint_add(level[2 * index],
+            bigint_mul(level[2 * index + 1], power));
+        }
+        if (level.size() % 2) {
+            level[pairs] = std::move(level[level.size() - 1]);
+        }
+        level.resize(pairs + level.size() % 2);
+
+        if (level.size() > 1) {
+            power = bigint_mul(power, power);
+        }
+    }
+
+    return level.empty() ? bigint_from_int(0) : level[0];
+}
+
+
+// Writes the digits of a, least significant first. a must be less than the
+// square of radix.powers[level], or the chunk value if level is -1. If pad is
+// true, writes leading zeros up to the full width such a number can have.
+static void radix_split(const limb_vec &a, int level,
+const radix_powers &radix, bool pad, int_vec &digits) {
+    if (level < 0 || a.size() <= RADIX_LEAF_LIMBS) {
+        // Small enough to peel off one limb's worth of digits at a time.
+        size_t width = pad ? radix.chunk_digits << (level + 1) : 0;
+        size_t start = digits.size();
+        limb_vec rest = a;
+        while (rest.size()) {
+            uint32_t value = mag_divmod_small(rest, radix.chunk_value);
+            bool last = rest.empty() && !pad;
+            for (size_t count = 0; count < radix.chunk_digits; ++count) {
+                if (last && value == 0) {
+                    break;
+                }
+                digits.push_back(value % radix.base);
+                value /= radix.base;
+            }
+        }
+        while (digits.size() - start < width) {
+            digits.push_back(0);
+        }
+        return;
+    }
+
+    // The low part has exactly as many digits as powers[level], with zeros.
+    // Every division at a level shares the same divisor and reciprocal.
+    const limb_vec &divisor = radix.powers[level].limbs;
+    limb_vec high;
+    limb_vec low;
+    if (radix.reciprocals[level].size() && a.size() > divisor.size()) {
+        barrett_divide(a, divisor, radix.reciprocals[level], high, low);
+    } else {
+        mag_divmod(a, divisor, high, low);
+    }
+
+    bool high_zero = high.empty();
+    radix_split(low, level - 1, radix, pad || !high_zero, digits);
+    if (pad || !high_zero) {
+        radix_split(high, level - 1, radix, pad, digits);
+    }
+    return;
+}
+
+
+// Writes the digits of |a| in a base from 2 to 36 into digits, least
+// significant first. Zero has the single digit 0. Splits by powers of the base
+// so that this takes O(M(n) log n).
+void bigint_to_digits(const bigint &a, int base, int_vec &digits) {
+    digits.clear();
+    if (a.limbs.empty()) {
+        digits.push_back(0);
+        return;
+    }
+
+    // powers[k] is chunk_value^(2^k), up to the first whose square exceeds a.
+    radix_powers radix;
+    radix_chunk(base, radix);
+    radix.powers.push_back(bigint_from_uint(radix.chunk_value));
+    while (2 * radix.powers.back().limbs.size() <= a.limbs.size() + 1) {
+        bigint square = bigint_mul(radix.powers.back(), radix.powers.back());
+        if (mag_compare(square.limbs, a.limbs) > 0) {
+            break;
+        }
+        radix.powers.push_back(square);
+    }
+    for (const bigint &power : radix.powers) {
+        bool large = power.limbs.size() >= BARRETT_THRESHOLD;
+        radix.reciprocals.push_back(large ? mag_reciprocal(power.limbs)
+        : limb_vec());
+    }
+
+    int level = radix.powers.size() - 1;
+    if (mag_compare(radix.powers[0].limbs, a.limbs) > 0) {
+        level = -1;
+    }
+    radix_split(a.limbs, level, radix, false, digits);
+    return;
+}
+
+
+// Returns true if a is zero.
+bool bigint_is_zero(const bigint &a) {
+    return a.limbs.empty();
+}
+
+
+// Returns true if a fits in an unsigned 128-bit integer and is not negative.
+bool bigint_fits_uint128(const bigint &a) {
+    return !a.negative && a.limbs.size() <= 4;
+}
+
+
+// Converts a non-negative big integer that fits in 128 bits.
+uint128 bigint_to_uint128(const bigint &a) {
+    uint128 result = 0;
+    for (size_t index = a.limbs.size(); index-- > 0;) {
+        result = (result << LIMB_BITS) | a.limbs[index];
+    }
+    return result;
+}
+
+
+// Compares a and b. Returns -1, 0 or 1.
+int bigint_compare(const bigint &a, const bigint &b) {
+    if (a.negative != b.negative) {
+        return a.negative ? -1 : 1;
+    }
+    int result = mag_compare(a.limbs, b.limbs);
+    return a.negative ? -result : result;
+}
+
+
+// Compares the absolute values of a and b. Returns -1, 0 or 1.
+int bigint_compare_abs(const bigint &a, const bigint &b) {
+    return mag_compare(a.limbs, b.limbs);
+}
+
+
+// Returns -a.
+bigint bigint_negate(const bigint &a) {
+    return make_bigint(!a.negative, a.limbs);
+}
+
+
+// Returns a + b.
+bigint bigint_add(const bigint &a, const bigint &b) {
+    if (a.negative == b.negative) {
+        return make_bigint(a.negative, mag_add(a.limbs, b.limbs));
+    }
+
+    // Signs differ, so subtract the smaller magnitude from the larger.
+    if (mag_compare(a.limbs, b.limbs) >= 0) {
+        return make_bigint(a.negative, mag_sub(a.limbs, b.limbs));
+    }
+    return make_bigint(b.negative, mag_sub(b.limbs, a.limbs));
+}
+
+
+// Returns a - b.
+bigint bigint_sub(const bigint &a, const bigint &b) {
+    return bigint_add(a, bigint_negate(b));
+}
+
+
+// Returns a * b. Uses Karatsuba multiplication for large operands.
+bigint bigint_mul(const bigint &a, const bigint &b) {
+    return make_bigint(a.negative != b.negative, mag_mul(a.limbs, b.limbs));
+}
+
+
+// Returns a * m for a small non-negative m.
+bigint bigint_mul_small(const bigint &a, uint32_t m) {
+    limb_vec limbs = a.limbs;
+    uint64_t carry = 0;
+    for (size_t index = 0; index < limbs.size(); ++index) {
+        carry += uint64_t(limbs[index]) * m;
+        limbs[index] = uint32_t(carry);
+        carry >>= LIMB_BITS;
+    }
+    if (carry) {
+        limbs.push_back(uint32_t(carry));
+    }
+    return make_bigint(a.negative, limbs);
+}
+
+
+// Divides a by b, rounding towards zero like the built-in integers. The
+// remainder has the same sign as a. Uses Newton reciprocals and Barrett
+// reduction for large operands.
+void bigint_divmod(const bigint &a, const bigint &b, bigint &q, bigint &r) {
+    if (b.limbs.empty()) {
+        std::cerr << RED << "Error: big integer division by zero." << RESET;
+        std::cerr << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    limb_vec q_limbs;
+    limb_vec r_limbs;
+    mag_divmod(a.limbs, b.limbs, q_limbs, r_limbs);
+    q = make_bigint(a.negative != b.negative, q_limbs);
+    r = make_bigint(a.negative, r_limbs);
+    return;
+}
+
+
+// Returns a / b, rounded towards zero.
+bigint bigint_div(const bigint &a, const bigint &b) {
+    bigint q;
+    bigint r;
+    bigint_divmod(a, b, q, r);
+    return q;
+}
+
+
+// Returns a % b, with the same sign as a.
+bigint bigint_mod(const bigint &a, const bigint &b) {
+    bigint q;
+    bigint r;
+    bigint_divmod(a, b, q, r);
+    return r;
+}
+
+
+// Returns a / b, rounded down.
+bigint bigint_floor_div(const bigint &a, const bigint &b) {
+    bigint q;
+    bigint r;
+    bigint_divmod(a, b, q, r);
+    if (!bigint_is_zero(r) && r.negative != b.negative) {
+        q = bigint_sub(q, bigint_from_int(1));
+    }
+    return q;
+}
+
+
+// Divides a by a small positive d in place and returns the remainder.
+uint32_t bigint_divmod_small(bigint &a, uint32_t d) {
+    uint32_t remainder = mag_divmod_small(a.limbs, d);
+    a.negative = a.negative && a.limbs.size();
+    return remainder;
+}
+
+
+// Returns |a| mod m for a positive 64-bit m.
+unsigned long long bigint_mod_uint(const bigint &a, unsigned long long m) {
+    uint128 remainder = 0;
+    for (size_t index = a.limbs.size(); index-- > 0;) {
+        remainder = ((remainder << LIMB_BITS) | a.limbs[index]) % m;
+    }
+    return (unsigned long long)(remainder);
+}
@@ -0,0 +1,134 @@
+/*
+Header file for arbitrary-precision integer functions.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#ifndef BIGINT_H
+#define BIGINT_H
+
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "debug.h"
+
+
+#define limb_vec std::vector<uint32_t>
+
+#define LIMB_BITS           32
+#define KARATSUBA_THRESHOLD 40 // Limbs. Below this, use schoolbook multiply.
+#define BARRETT_THRESHOLD   200 // Limbs. Below this, use long division.
+#define RADIX_LEAF_LIMBS    30 // Limbs. Below this, convert bases directly.
+
+
+// An arbitrary-precision integer. Limbs are base 2^32, least significant
+// first, with no leading zero limbs. Zero has no limbs and is never negative.
+typedef struct bigint {
+    bool negative;
+    limb_vec limbs;
+} bigint;
+
+
+// Creates a big integer from a signed 64-bit integer.
+bigint bigint_from_int(long long value);
+
+
+// Creates a big integer from an unsigned 64-bit integer.
+bigint bigint_from_uint(unsigned long long value);
+
+
+// Creates a big integer from an unsigned 128-bit integer.
+bigint bigint_from_uint128(uint128 value);
+
+
+// Reads a decimal string with an optional leading sign. Returns false if the
+// string is not a valid integer.
+bool bigint_from_string(const str &input, bigint &result);
+
+
+// Returns the decimal representation of a big integer.
+str bigint_to_string(const bigint &a);
+
+
+// Creates a big integer from its digits in a base from 2 to 36, most
+// significant first. Digits must be less than the base.
+bigint bigint_from_digits(const int_vec &digits, int base);
+
+
+// Writes the digits of |a| in a base from 2 to 36 into digits, least
+// significant first. Zero has the single digit 0. Splits by powers of the base
+// so that this takes O(M(n) log n).
+void bigint_to_digits(const bigint &a, int base, int_vec &digits);
+
+
+// Returns true if a is zero.
+bool bigint_is_zero(const bigint &a);
+
+
+// Returns true if a fits in an unsigned 128-bit integer and is not negative.
+bool bigint_fits_uint128(const bigint &a);
+
+
+// Converts a non-negative big integer that fits in 128 bits.
+uint128 bigint_to_uint128(const bigint &a);
+
+
+// Compares a and b. Returns -1, 0 or 1.
+int bigint_compare(const bigint &a, const bigint &b);
+
+
+// Compares the absolute values of a and b. Returns -1, 0 or 1.
+int bigint_compare_abs(const bigint &a, const bigint &b);
+
+
+// Returns -a.
+bigint bigint_negate(const bigint &a);
+
+
+// Returns a + b.
+bigint bigint_add(const bigint &a, const bigint &b);
+
+
+// Returns a - b.
+bigint bigint_sub(const bigint &a, const bigint &b);
+
+
+// Returns a * b. Uses Karatsuba multiplication for large operands.
+bigint bigint_mul(const bigint &a, const bigint &b);
+
+
+// Returns a * m for a small non-negative m.
+bigint bigint_mul_small(const bigint &a, uint32_t m);
+
+
+// Divides a by b, rounding towards zero like the built-in integers. The
+// remainder has the same sign as a. Uses Newton reciprocals and Barrett
+// reduction for large operands.
+void bigint_divmod(const bigint &a, const bigint &b, bigint &q, bigint &r);
+
+
+// Returns a / b, rounded towards zero.
+bigint bigint_div(const bigint &a, const bigint &b);
+
+
+// Returns a % b, with the same sign as a.
+bigint bigint_mod(const bigint &a, const bigint &b);
+
+
+// Returns a / b, rounded down.
+bigint bigint_floor_div(const bigint &a, const bigint &b);
+
+
+// Divides a by a small positive d in place and returns the remainder.
+uint32_t bigint_divmod_small(bigint &a, uint32_t d);
+
+
+// Returns |a| mod m for a positive 64-bit m.
+unsigned long long bigint_mod_uint(const bigint &a, unsigned long long m);
+
+
+#endif
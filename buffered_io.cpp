@@ -0,0 +1,165 @@
+/*
+Implementation of buffered input and output functions.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#include "buffered_io.h"
+
+
+// Refills the input buffer. Returns false if the stream has no more data.
+static bool refill(input_buffer &in) {
+    if (in.position < in.length) {
+        return true;
+    }
+
+    in.stream->read(in.data.data(), in.data.size());
+    in.length = in.stream->gcount();
+    in.position = 0;
+    return in.length > 0;
+}
+
+
+// Sets up an input buffer that reads from stream.
+void init_input_buffer(input_buffer &in, std::istream &stream) {
+    in.stream = &stream;
+    in.data.assign(IO_BUFFER_SIZE, '\0');
+    in.position = 0;
+    in.length = 0;
+    return;
+}
+
+
+// Reads the next whitespace-separated integer. Returns false at the end of
+// input or if the next token is not an integer.
+bool read_int(input_buffer &in, int &value) {
+    // Skip whitespace.
+    while (refill(in) && isspace((unsigned char)(in.data[in.position]))) {
+        ++in.position;
+    }
+    if (!refill(in)) {
+        return false;
+    }
+
+    bool negative = in.data[in.position] == '-';
+    if (negative || in.data[in.position] == '+') {
+        ++in.position;
+    }
+
+    // Accumulate digits until the end of the token.
+    // Values beyond the range of a 64-bit integer are rejected.
+    const unsigned long long limit = negative ? 9223372036854775808ULL
+    : 9223372036854775807ULL;
+    bool digits_read = false;
+    bool overflow = false;
+    unsigned long long magnitude = 0;
+    while (refill(in) && isdigit((unsigned char)(in.data[in.position]))) {
+        unsigned long long digit = in.data[in.position] - '0';
+        overflow = overflow || magnitude > (limit - digit) / 10;
+        magnitude = magnitude * 10 + digit;
+        digits_read = true;
+        ++in.position;
+    }
+    bool trailing = refill(in)
+    && !isspace((unsigned char)(in.data[in.position]));
+    if (overflow || trailing) {
+        return false;
+    }
+
+    value = negative ? 0 - magnitude : magnitude;
+    return digits_read;
+}
+
+
+// Reads the next line without its newline, reusing the storage in line.
+// Returns false at the end of input.
+bool read_line(input_buffer &in, str &line) {
+    line.clear();
+    if (!refill(in)) {
+        return false;
+    }
+
+    while (refill(in)) {
+        // Copy up to the next newline in one go.
+        const char *start = in.data.data() + in.position;
+        const char *end = in.data.data() + in.length;
+        const char *newline = std::find(start, end, '\n');
+        line.append(start, newline);
+        in.position += newline - start;
+        if (newline != end) {
+            ++in.position;
+            break;
+        }
+    }
+
+    if (line.size() && line[line.size() - 1] == '\r') {
+        line.pop_back();
+    }
+    return true;
+}
+
+
+// Sets up an output buffer that writes to stream.
+void init_output_buffer(output_buffer &out, std::ostream &stream) {
+    out.stream = &stream;
+    out.data.clear();
+    out.data.reserve(IO_BUFFER_SIZE);
+    return;
+}
+
+
+// Writes the buffer out once it is full.
+static void flush_if_full(output_buffer &out) {
+    if (out.data.size() >= IO_BUFFER_SIZE) {
+        flush_output(out);
+    }
+    return;
+}
+
+
+// Appends an integer to the output buffer.
+void write_int(output_buffer &out, int value) {
+    // Write digits right to left into a small local buffer.
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *start = end;
+    unsigned long long magnitude = value < 0 ? 0 - (unsigned long long)(value)
+    : value;
+    do {
+        *--start = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) {
+        *--start = '-';
+    }
+
+    out.data.append(start, end);
+    flush_if_full(out);
+    return;
+}
+
+
+// Appends a string to the output buffer.
+void write_str(output_buffer &out, const str &text) {
+    out.data += text;
+    flush_if_full(out);
+    return;
+}
+
+
+// Appends a character to the output buffer.
+void write_char(output_buffer &out, char ch) {
+    out.data += ch;
+    flush_if_full(out);
+    return;
+}
+
+
+// Writes everything in the output buffer to its stream.
+void flush_output(output_buffer &out) {
+    out.stream->write(out.data.data(), out.data.size());
+    out.data.clear();
+    return;
+}
@@ -0,0 +1,73 @@
+/*
+Header file for buffered input and output functions, used when reading or
+writing large amounts of data.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#ifndef BUFFERED_IO_H
+#define BUFFERED_IO_H
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "debug.h"
+
+
+#define IO_BUFFER_SIZE 65536 // Bytes read or written at a time.
+
+
+// Reads a stream in large blocks.
+typedef struct input_buffer {
+    std::istream *stream;
+    std::vector<char> data;
+    size_t position;
+    size_t length;
+} input_buffer;
+
+
+// Collects output and writes it to a stream in large blocks.
+typedef struct output_buffer {
+    std::ostream *stream;
+    str data;
+} output_buffer;
+
+
+// Sets up an input buffer that reads from stream.
+void init_input_buffer(input_buffer &in, std::istream &stream);
+
+
+// Reads the next whitespace-separated integer. Returns false at the end of
+// input or if the next token is not an integer.
+bool read_int(input_buffer &in, int &value);
+
+
+// Reads the next line without its newline, reusing the storage in line.
+// Returns false at the end of input.
+bool read_line(input_buffer &in, str &line);
+
+
+// Sets up an output buffer that writes to stream.
+void init_output_buffer(output_buffer &out, std::ostream &stream);
+
+
+// Appends an integer to the output buffer.
+void write_int(output_buffer &out, int value);
+
+
+// Appends a string to the output buffer.
+void write_str(output_buffer &out, const str &text);
+
+
+// Appends a character to the output buffer.
+void write_char(output_buffer &out, char ch);
+
+
+// Writes everything in the output buffer to its stream.
+void flush_output(output_buffer &out);
+
+
+#endif
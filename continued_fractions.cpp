@@ -2,7 +2,7 @@
 Implementation of continued fraction functions.
 
 WRitten by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -14,9 +14,21 @@ Last updated 19 August 2022.
 int do_convert_cont_frac(void) {
     // Read input from user.
     print_limitations_cf_convert();
-    int numerator;
-    int denominator;
-    take_input_cf_convert(numerator, denominator);
+    bigint big_num;
+    bigint big_den;
+    take_input_cf_convert(big_num, big_den);
+
+    // Large fractions skip the table and use big integers throughout.
+    if (!fits_cf_table(big_num, big_den)) {
+        std::vector<bigint> quotients;
+        big_cont_frac(big_num, big_den, quotients);
+        std::cout << bigint_to_string(big_num) << " / ";
+        std::cout << bigint_to_string(big_den) << " = ";
+        print_big_cont_frac(quotients);
+        return 0;
+    }
+    int numerator = bigint_to_uint128(big_num);
+    int denominator = bigint_to_uint128(big_den);
 
     // Set up and run extended Euclidean algorithm.
     int_v q;
@@ -37,22 +49,181 @@ int do_convert_cont_frac(void) {
 int do_cont_frac_convergents(void) {
     // Read input from user.
     print_limitations_cf_converge();
+    bigint big_num;
+    bigint big_den;
+    take_input_cf_convert(big_num, big_den);
+
+    // Fractions beyond 64 bits use big integers throughout.
+    bigint limit = bigint_from_int(INT64_MAX);
+    if (bigint_compare(big_num, limit) > 0
+    || bigint_compare(big_den, limit) > 0) {
+        std::vector<bigint> quotients;
+        big_cont_frac(big_num, big_den, quotients);
+        std::cout << bigint_to_string(big_num) << " / ";
+        std::cout << bigint_to_string(big_den) << " = ";
+        print_big_cont_frac(quotients);
+        print_big_convergents(quotients);
+        return 0;
+    }
+    int numerator = bigint_to_uint128(big_num);
+    int denominator = bigint_to_uint128(big_den);
+
+    // One pass of the stream gives each quotient with its convergent. A 64-bit
+    // fraction has fewer than 100 quotients, so the convergents are held back
+    // until the continued fraction has been printed.
+    convergent_stream stream;
+    init_convergent_stream(stream, numerator, denominator);
+    str convergents;
+    std::cout << numerator << " / " << denominator << " = [";
+    for (int index = 0; stream.has_next; ++index) {
+        std::cout << (index == 0 ? "" : index == 1 ? "; " : ", ");
+        std::cout << stream.next_quotient;
+        next_convergent(stream);
+        convergents += format_stream_convergent(stream, index);
+    }
+    std::cout << "]\n\n" << convergents;
+    return 0;
+}
+
+
+// The main code that finds the best approximation to a fraction with a
+// bounded denominator.
+int do_best_approximation(void) {
+    print_limitations_best();
     int numerator;
     int denominator;
-    take_input_cf_convert(numerator, denominator);
+    int limit;
+    take_input_best(numerator, denominator, limit);
 
-    // Vectors to be used in converting to continued fraction and calculating
-    // convergents and error bounds.
-    int_v q;
-    int_v r;
-    int_v x;
-    int_v y;
+    int p;
+    int q;
+    best_approximation(numerator, denominator, limit, p, q);
 
-    // Convert to continued fraction.
-    auto_cont_frac(numerator, denominator, q, r, x, y);
+    // The error is |n / d - p / q| = |nq - dp| / dq.
+    int128 difference = (int128)(numerator) * q - (int128)(denominator) * p;
+    std::cout << "\nBest approximation to " << numerator << " / ";
+    std::cout << denominator << " with denominator at most " << limit;
+    std::cout << ": " << p << " / " << q << "\n";
+    std::cout << "The error is ";
+    std::cout << bigint_to_string(bigint_from_uint128(difference < 0
+    ? -difference : difference)) << " / ";
+    std::cout << bigint_to_string(bigint_mul(bigint_from_int(denominator),
+    bigint_from_int(q))) << "\n\n";
+    return 0;
+}
 
-    // Print the convergents and error bounds.
-    print_convergents(q, x, y);
+
+// The main code that finds the continued fraction of (P + sqrt(D)) / Q.
+int do_quadratic_cont_frac(void) {
+    int P;
+    int D;
+    int Q;
+    take_input_quadratic(P, D, Q);
+
+    int_v terms;
+    size_t preperiod;
+    int status = quadratic_cont_frac(P, D, Q, terms, preperiod);
+    if (status == QUADRATIC_NONE) {
+        std::cerr << RED << "Error: D must not be a square and the numbers ";
+        std::cerr << "must be at most 10^18." << RESET << "\n";
+        return EXIT_FAILURE;
+    } else if (status == QUADRATIC_TOO_LONG) {
+        std::cerr << RED << "Error: the continued fraction has more than ";
+        std::cerr << MAX_QUADRATIC_TERMS << " terms before the end of its ";
+        std::cerr << "period." << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n(" << P << " + sqrt(" << D << ")) / " << Q << " = ";
+    std::cout << format_quadratic_cf(terms, preperiod) << "\n";
+    std::cout << "Terms before the period: " << preperiod << "\n";
+    std::cout << "Terms in the period: " << terms.size() - preperiod;
+    std::cout << "\n\n";
+    return 0;
+}
+
+
+// The main code that solves Pell's equation x^2 - Dy^2 = 1 or -1.
+int do_solve_pell(void) {
+    print_limitations_pell();
+    int D;
+    bool negative;
+    int n;
+    take_input_pell(D, negative, n);
+
+    bigint x;
+    bigint y;
+    int status = solve_pell(D, negative, x, y);
+    if (status == QUADRATIC_TOO_LONG) {
+        std::cerr << RED << "Error: the period of sqrt(" << D << ") has more ";
+        std::cerr << "than " << MAX_QUADRATIC_TERMS << " terms." << RESET;
+        std::cerr << "\n";
+        return EXIT_FAILURE;
+    } else if (status == QUADRATIC_NONE) {
+        std::cout << "\nx^2 - " << D << "y^2 = " << (negative ? "-1" : "1");
+        std::cout << " has no solutions in positive integers.\n\n";
+        return 0;
+    }
+
+    // Odd powers of a solution to -1 are again solutions to -1.
+    bigint x_n;
+    bigint y_n;
+    pell_power(D, x, y, negative ? 2 * n - 1 : n, x_n, y_n);
+    std::cout << "\nSolution " << n << " of x^2 - " << D << "y^2 = ";
+    std::cout << (negative ? "-1" : "1") << ":\n";
+    std::cout << "x = " << bigint_to_string(x_n) << "\n";
+    std::cout << "y = " << bigint_to_string(y_n) << "\n\n";
+    return 0;
+}
+
+
+// The main code that adds, subtracts, multiplies or divides two continued
+// fractions.
+int do_cf_arithmetic(void) {
+    int x[3];
+    int y[3];
+    char op;
+    int count;
+    take_input_cf_arithmetic(x, y, op, count);
+
+    cf_source x_source;
+    cf_source y_source;
+    if (!init_cf_source(x_source, x[0], x[1], x[2])
+    || !init_cf_source(y_source, y[0], y[1], y[2])) {
+        std::cerr << RED << "Error: the numbers must be at most 10^18.";
+        std::cerr << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+
+    gosper_state state;
+    init_gosper(state, op, x_source, y_source);
+    bigint term;
+    int status = next_gosper_term(state, term);
+    if (status == GOSPER_UNDEFINED) {
+        std::cerr << RED << "Error: division by zero." << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // Print each term as soon as it is known.
+    std::cout << "\nx = " << (x[1] ? "(" : "") << x[0];
+    std::cout << (x[1] ? " + sqrt(" + std::to_string(x[1]) + "))" : "");
+    std::cout << " / " << x[2] << "\ny = " << (y[1] ? "(" : "") << y[0];
+    std::cout << (y[1] ? " + sqrt(" + std::to_string(y[1]) + "))" : "");
+    std::cout << " / " << y[2] << "\n\nx " << op << " y = [";
+    for (int index = 0; index < count && status == GOSPER_TERM; ++index) {
+        std::cout << (index == 0 ? "" : index == 1 ? "; " : ", ");
+        std::cout << bigint_to_string(term) << std::flush;
+        status = next_gosper_term(state, term);
+    }
+    std::cout << (status == GOSPER_TERM ? ", ...]" : "]") << "\n\n";
+
+    if (status == GOSPER_UNDECIDED) {
+        std::cout << YELLOW << "The next term could not be decided after ";
+        std::cout << MAX_IDLE_TERMS << " more terms of x and y. The result ";
+        std::cout << "is probably a rational number lying exactly on the ";
+        std::cout << "boundary between two possible next terms.";
+        std::cout << RESET << "\n\n";
+    }
     return 0;
 }
 
@@ -61,7 +232,8 @@ int do_cont_frac_convergents(void) {
 void print_limitations_cf_convert(void) {
     std::cerr << "Limitations:\n";
 
-    std::cerr << "- Maximum numerator/denominator is 10^8.\n";
+    std::cerr << "- Numerators/denominators above 10^8 use arbitrary ";
+    std::cerr << "precision and skip the table of working.\n";
     std::cerr << "- Minimum numerator/denominator is 0.\n\n";
 
     return;
@@ -72,10 +244,9 @@ void print_limitations_cf_convert(void) {
 void print_limitations_cf_converge(void) {
     std::cerr << "Limitations:\n";
 
-    std::cerr << "- Maximum numerator/denominator is 10^8.\n";
-    std::cerr << "- Minimum numerator/denominator is 0.\n";
-    std::cerr << "- May not print all convergents due to risk of integer ";
-    std::cerr << "overflow.\n\n";
+    std::cerr << "- Numerators/denominators beyond 64 bits use arbitrary ";
+    std::cerr << "precision.\n";
+    std::cerr << "- Minimum numerator/denominator is 0.\n\n";
 
     return;
 }
@@ -94,14 +265,15 @@ void auto_cont_frac(int n, int d, int_v &q, int_v &r, int_v &x, int_v &y) {
 }
 
 
-// Reads numerator and denominator fron user.
-void take_input_cf_convert(int &num, int &den) {
+// Reads numerator and denominator of any size from user.
+void take_input_cf_convert(bigint &num, bigint &den) {
     // Read numerator.
+    str input;
     std::cerr << "Enter numerator: ";
-    if (std::cin >> num) {
+    if (std::cin >> input && bigint_from_string(input, num)) {
         // Numerator successfully read. Read denominator.
         std::cerr << "Enter denominator: ";
-        if (std::cin >> den) {
+        if (std::cin >> input && bigint_from_string(input, den)) {
             // Do nothing.
         } else {
             std::cerr << RED << "Error reading denominator." << RESET << "\n";
@@ -113,10 +285,10 @@ void take_input_cf_convert(int &num, int &den) {
     }
 
     // Error checking.
-    if (num < 0 || num > MAX_INPUT) {
+    if (num.negative) {
         std::cerr << RED << "Error: invalid numerator." << RESET << "\n";
         exit(EXIT_FAILURE);
-    } else if (den <= 0 || den > MAX_INPUT) {
+    } else if (den.negative || bigint_is_zero(den)) {
         std::cerr << RED << "Error: invalid denominator." << RESET << "\n";
         exit(EXIT_FAILURE);
     }
@@ -125,6 +297,97 @@ void take_input_cf_convert(int &num, int &den) {
 }
 
 
+// Returns whether a fraction is small enough to show the table of working.
+bool fits_cf_table(const bigint &num, const bigint &den) {
+    bigint limit = bigint_from_int(MAX_INPUT);
+    return bigint_compare(num, limit) <= 0 && bigint_compare(den, limit) <= 0;
+}
+
+
+// Finds the quotients of the continued fraction of n / d, for n and d of any
+// size.
+void big_cont_frac(bigint n, bigint d, std::vector<bigint> &quotients) {
+    quotients.clear();
+    bigint quotient;
+    bigint remainder;
+    while (!bigint_is_zero(d)) {
+        bigint_divmod(n, d, quotient, remainder);
+        quotients.push_back(quotient);
+        n = std::move(d);
+        d = std::move(remainder);
+    }
+    return;
+}
+
+
+// Prints a continued fraction with quotients of any size.
+void print_big_cont_frac(const std::vector<bigint> &quotients) {
+    std::cout << "[";
+    for (size_t index = 0; index < quotients.size(); ++index) {
+        std::cout << bigint_to_string(quotients[index]);
+        if (index == 0 && quotients.size() > 1) {
+            std::cout << "; ";
+        } else if (index + 1 < quotients.size()) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << "]\n\n";
+    return;
+}
+
+
+// Starts the convergent recurrence before the first quotient.
+void init_big_convergent(big_convergent &convergent) {
+    // p_(-1) / q_(-1) = 1 / 0 and p_(-2) / q_(-2) = 0 / 1.
+    convergent.p = bigint_from_int(1);
+    convergent.q = bigint_from_int(0);
+    convergent.p_prev = bigint_from_int(0);
+    convergent.q_prev = bigint_from_int(1);
+    return;
+}
+
+
+// Moves to the next convergent, given the next quotient.
+void next_big_convergent(big_convergent &convergent, const bigint &quotient) {
+    bigint p = bigint_add(bigint_mul(quotient, convergent.p),
+    convergent.p_prev);
+    bigint q = bigint_add(bigint_mul(quotient, convergent.q),
+    convergent.q_prev);
+    convergent.p_prev = std::move(convergent.p);
+    convergent.q_prev = std::move(convergent.q);
+    convergent.p = std::move(p);
+    convergent.q = std::move(q);
+    return;
+}
+
+
+// Prints every convergent of a continued fraction with quotients of any size,
+// and its error bound.
+void print_big_convergents(const std::vector<bigint> &quotients) {
+    // Each convergent comes from the two before it, so none are stored.
+    big_convergent convergent;
+    init_big_convergent(convergent);
+    for (size_t index = 0; index < quotients.size(); ++index) {
+        next_big_convergent(convergent, quotients[index]);
+        std::cout << "Convergent " << index << ": ";
+        std::cout << bigint_to_string(convergent.p) << " / ";
+        std::cout << bigint_to_string(convergent.q) << "\n";
+
+        // The error bound is 1 / (a_(k+1) q_k^2). The last convergent is the
+        // fraction itself.
+        if (index + 1 == quotients.size()) {
+            std::cout << "This is the fraction itself.\n\n";
+        } else {
+            bigint bound = bigint_mul(quotients[index + 1],
+            bigint_mul(convergent.q, convergent.q));
+            std::cout << "The error bound for this is 1 / ";
+            std::cout << bigint_to_string(bound) << "\n\n";
+        }
+    }
+    return;
+}
+
+
 // Prints a continued fraction when given a vector containing quotients from
 // Euclidean algorithm.
 void print_cont_frac(int_v quotients) {
@@ -152,80 +415,721 @@ void print_cont_frac(int_v quotients) {
 }
 
 
-// Prints the absolute value of the integer input.
-int absolute_val(int input) {
-    if (input < 0) {
-        return (input * -1);
+// Starts a convergent generator for n / d, with n >= 0 and d > 0.
+void init_convergent_stream(convergent_stream &stream, int n, int d) {
+    // Start from 1 / 0 and 0 / 1, with the first quotient already found.
+    stream.next_quotient = n / d;
+    stream.n = d;
+    stream.d = n % d;
+    stream.has_next = true;
+    stream.p = 1;
+    stream.q = 0;
+    stream.p_prev = 0;
+    stream.q_prev = 1;
+    stream.bound = 0;
+    return;
+}
+
+
+// Moves to the next convergent and its error bound. Returns false once every
+// convergent has been generated. Nothing is stored, so each step is one
+// division and a few multiplications.
+bool next_convergent(convergent_stream &stream) {
+    if (!stream.has_next) {
+        return false;
     }
-    return input;
+
+    // p_k = a_k p_(k-1) + p_(k-2), and likewise for q_k.
+    int quotient = stream.next_quotient;
+    int p = quotient * stream.p + stream.p_prev;
+    int q = quotient * stream.q + stream.q_prev;
+    stream.p_prev = stream.p;
+    stream.q_prev = stream.q;
+    stream.p = p;
+    stream.q = q;
+
+    // Look one quotient ahead for the error bound.
+    stream.has_next = stream.d != 0;
+    stream.bound = 0;
+    if (stream.has_next) {
+        stream.next_quotient = stream.n / stream.d;
+        int remainder = stream.n - stream.next_quotient * stream.d;
+        stream.n = stream.d;
+        stream.d = remainder;
+        stream.bound = (uint128)(stream.next_quotient) * q * q;
+    }
+    return true;
 }
 
 
-// Prints convergents.
-void print_convergents(int_v q, int_v x, int_v y) {    
-    // Use of index here refers to the index in vector q.
-    for (size_t index = 0; index < q.size(); ++index) {
-        // Determine if convergent is positive or negative.
-        bool convergent_negative = false;
-        if (x[index + 2] < 0 && y[index + 2] < 0) {
-            convergent_negative = true;
-        } else if (x[index + 2] >= 0 && y[index + 2] >= 0) {
-            convergent_negative = true;
-        }
-        
-        // Terminate program if necessary to prevent integer overflow.
-        if (x[index + 2] > MAX_INPUT || y[index + 2] > MAX_INPUT) {
-            print_convergent_stop(index);
+// Writes the current convergent of a stream and its error bound, as convergent
+// number index.
+str format_stream_convergent(const convergent_stream &stream, int index) {
+    str result = "Convergent " + std::to_string(index) + ": "
+    + std::to_string(stream.p) + " / " + std::to_string(stream.q) + "\n";
+    if (stream.bound == 0) {
+        return result + "This is the fraction itself.\n\n";
+    }
+    return result + "The error bound for this is 1 / "
+    + bigint_to_string(bigint_from_uint128(stream.bound)) + "\n\n";
+}
+
+
+// Prints limitations for best approximations.
+void print_limitations_best(void) {
+    std::cerr << "Limitations:\n";
+
+    std::cerr << "- Numerator, denominator and the largest denominator ";
+    std::cerr << "allowed must fit in 64 bits.\n";
+    std::cerr << "- Minimum numerator is 0, minimum denominators are 1.\n\n";
+
+    return;
+}
+
+
+// Reads a fraction and the largest denominator allowed from user.
+void take_input_best(int &num, int &den, int &limit) {
+    std::cerr << "Enter numerator: ";
+    if (!(std::cin >> num) || num < 0) {
+        std::cerr << RED << "Error: invalid numerator." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cerr << "Enter denominator: ";
+    if (!(std::cin >> den) || den <= 0) {
+        std::cerr << RED << "Error: invalid denominator." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cerr << "Enter largest denominator allowed: ";
+    if (!(std::cin >> limit) || limit <= 0) {
+        std::cerr << RED << "Error: invalid largest denominator." << RESET;
+        std::cerr << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return;
+}
+
+
+// Finds p / q closest to n / d with q at most limit, choosing the smaller q on
+// a tie. Runs the Euclidean algorithm only until the convergents pass the
+// limit, then picks between the last convergent and the best semiconvergent,
+// so it takes O(log limit) steps and allocates nothing.
+void best_approximation(int n, int d, int limit, int &p, int &q) {
+    // p / q is the latest convergent and p_prev / q_prev the one before,
+    // starting from 1 / 0 and 0 / 1.
+    int p_prev = 0;
+    int q_prev = 1;
+    p = 1;
+    q = 0;
+    while (d != 0) {
+        int quotient = n / d;
+        int remainder = n % d;
+
+        // Stop if the next convergent's denominator would pass the limit.
+        if (q != 0 && quotient > (limit - q_prev) / q) {
+            // The best semiconvergent below the limit is (tp + p_prev) /
+            // (tq + q_prev). It only beats the convergent if it is closer.
+            int t = (limit - q_prev) / q;
+            if (t == 0) {
+                return;
+            }
+
+            // With x' = n / d the rest of the continued fraction, the
+            // convergent is off by 1 / (q (x'q + q_prev)) and the
+            // semiconvergent by 1 / (q semi_q) minus that, so the
+            // semiconvergent wins when x'q < 2tq + q_prev.
+            uint64_t twice_semi_q = 2 * (uint64_t)(t * q + q_prev) - q_prev;
+            if ((uint128)(n) * q < (uint128)(d) * twice_semi_q) {
+                p = t * p + p_prev;
+                q = t * q + q_prev;
+            }
             return;
         }
 
-        // Get the absolute values of x and y.
-        int x_value = absolute_val(x[index + 2]);
-        int y_value = absolute_val(y[index + 2]);
+        int next_p = quotient * p + p_prev;
+        int next_q = quotient * q + q_prev;
+        p_prev = p;
+        q_prev = q;
+        p = next_p;
+        q = next_q;
+        n = d;
+        d = remainder;
+    }
+    return;
+}
+
 
-        // Print the convergent and its error bound.
-        std::cout << "Convergent " << index << ": ";
-        if (convergent_negative) {
-            std::cout << "-";
+// Returns the largest integer whose square is at most n, for n >= 0.
+int integer_sqrt(int n) {
+    // Start from the floating point root and correct its rounding.
+    int root = std::sqrt((long double)(n));
+    while (root > 0 && (int128)(root) * root > n) {
+        --root;
+    }
+    while ((int128)(root + 1) * (root + 1) <= n) {
+        ++root;
+    }
+    return root;
+}
+
+
+// Returns a / b rounded down, for b != 0.
+static int floor_div(int a, int b) {
+    int quotient = a / b;
+    if (a % b != 0 && (a < 0) != (b < 0)) {
+        --quotient;
+    }
+    return quotient;
+}
+
+
+// Returns the next term of the continued fraction of (P + sqrt(D)) / Q, and
+// moves P and Q on to the rest of it. root is the integer part of sqrt(D).
+static int quadratic_step(int &P, int &Q, int D, int root) {
+    // sqrt(D) lies strictly between root and root + 1, which decides the floor
+    // when Q is negative.
+    int term = Q > 0 ? floor_div(P + root, Q) : floor_div(P + root + 1, Q);
+    P = term * Q - P;
+    Q = (D - (int128)(P) * P) / Q;
+    return term;
+}
+
+
+// Checks that (P + sqrt(D)) / Q is in range and makes Q divide D - P^2, which
+// quadratic_step needs. Returns false if Q is 0 or the numbers are too large.
+static bool normalise_quadratic(int &P, int &D, int &Q) {
+    if (Q == 0 || D <= 0 || D > MAX_QUADRATIC_D || std::abs(P) > MAX_QUADRATIC_D
+    || std::abs(Q) > MAX_QUADRATIC_D) {
+        return false;
+    }
+
+    // If Q does not divide D - P^2, multiply the top and bottom by |Q|, which
+    // keeps the value the same.
+    if ((D - (int128)(P) * P) % Q != 0) {
+        int128 wide_D = (int128)(D) * Q * Q;
+        int128 wide_P = (int128)(P) * Q;
+        if (wide_D > MAX_QUADRATIC_D || wide_P > MAX_QUADRATIC_D
+        || wide_P < -MAX_QUADRATIC_D) {
+            return false;
         }
-        std::cout << y_value << " / " << x_value << "\n";
+        D = wide_D;
+        P *= std::abs(Q);
+        Q *= std::abs(Q);
+    }
+    return true;
+}
 
-        // Check that index is valid before calculating error bound.
-        if ((index + 1) >= q.size() || (index + 2) >= x.size()) {
-            std::cout << "Error bound cannot be calculated without illegal ";
-            std::cout << "memory access.\n\n";
-            return;
+
+// Finds the continued fraction of (P + sqrt(D)) / Q, which is eventually
+// periodic. terms holds the terms before the period and then one period,
+// which starts at index preperiod. Returns QUADRATIC_NONE if D is a perfect
+// square, Q is 0, or the numbers are too large, and QUADRATIC_TOO_LONG if
+// there are more than MAX_QUADRATIC_TERMS terms up to the end of the period.
+int quadratic_cont_frac(int P, int D, int Q, int_v &terms, size_t &preperiod) {
+    terms.clear();
+    preperiod = 0;
+    if (!normalise_quadratic(P, D, Q)) {
+        return QUADRATIC_NONE;
+    }
+    int root = integer_sqrt(D);
+    if (root * root == D) {
+        return QUADRATIC_NONE;
+    }
+
+    // Find where the (P, Q) pairs start repeating with Brent's algorithm, so
+    // no pairs need to be stored. The period of sqrt(D) can be near sqrt(D)
+    // terms, so give up once Brent's algorithm has taken more steps than an
+    // allowed period and preperiod could need.
+    int steps = 0;
+    int power = 1;
+    int length = 1;
+    int tortoise_P = P;
+    int tortoise_Q = Q;
+    int hare_P = P;
+    int hare_Q = Q;
+    quadratic_step(hare_P, hare_Q, D, root);
+    while (tortoise_P != hare_P || tortoise_Q != hare_Q) {
+        if (power == length) {
+            tortoise_P = hare_P;
+            tortoise_Q = hare_Q;
+            power *= 2;
+            length = 0;
+        }
+        quadratic_step(hare_P, hare_Q, D, root);
+        ++length;
+        if (++steps > 3 * MAX_QUADRATIC_TERMS) {
+            return QUADRATIC_TOO_LONG;
+        }
+    }
+    if (length > MAX_QUADRATIC_TERMS) {
+        return QUADRATIC_TOO_LONG;
+    }
+
+    tortoise_P = P;
+    tortoise_Q = Q;
+    hare_P = P;
+    hare_Q = Q;
+    for (int step = 0; step < length; ++step) {
+        quadratic_step(hare_P, hare_Q, D, root);
+    }
+    while (tortoise_P != hare_P || tortoise_Q != hare_Q) {
+        quadratic_step(tortoise_P, tortoise_Q, D, root);
+        quadratic_step(hare_P, hare_Q, D, root);
+        ++preperiod;
+    }
+    if (preperiod + length > MAX_QUADRATIC_TERMS) {
+        preperiod = 0;
+        return QUADRATIC_TOO_LONG;
+    }
+
+    // Replay the terms up to the end of the first period.
+    terms.reserve(preperiod + length);
+    for (size_t index = 0; index < preperiod + length; ++index) {
+        terms.push_back(quadratic_step(P, Q, D, root));
+    }
+    return QUADRATIC_FOUND;
+}
+
+
+// Writes a periodic continued fraction with the period in brackets, so
+// sqrt(7) is [2; (1, 1, 1, 4)].
+str format_quadratic_cf(const int_v &terms, size_t preperiod) {
+    str result = "[";
+    for (size_t index = 0; index < terms.size(); ++index) {
+        if (index == 1) {
+            result += "; ";
+        } else if (index > 1) {
+            result += ", ";
+        }
+        if (index == preperiod) {
+            result += "(";
+        }
+        result += std::to_string(terms[index]);
+    }
+    return result + ")]";
+}
+
+
+// Multiplies the matrices [[a, 1], [1, 0]] for terms[low] to terms[high - 1],
+// splitting the range in half so that the big multiplications are balanced.
+// The product is [[m[0], m[1]], [m[2], m[3]]].
+static void term_matrix_product(const int_v &terms, size_t low, size_t high,
+bigint m[4]) {
+    if (high - low == 1) {
+        m[0] = bigint_from_int(terms[low]);
+        m[1] = bigint_from_int(1);
+        m[2] = bigint_from_int(1);
+        m[3] = bigint_from_int(0);
+        return;
+    }
+
+    bigint left[4];
+    bigint right[4];
+    size_t middle = low + (high - low) / 2;
+    term_matrix_product(terms, low, middle, left);
+    term_matrix_product(terms, middle, high, right);
+    m[0] = bigint_add(bigint_mul(left[0], right[0]),
+    bigint_mul(left[1], right[2]));
+    m[1] = bigint_add(bigint_mul(left[0], right[1]),
+    bigint_mul(left[1], right[3]));
+    m[2] = bigint_add(bigint_mul(left[2], right[0]),
+    bigint_mul(left[3], right[2]));
+    m[3] = bigint_add(bigint_mul(left[2], right[1]),
+    bigint_mul(left[3], right[3]));
+    return;
+}
+
+
+// Finds the smallest positive solution of x^2 - Dy^2 = 1, or of
+// x^2 - Dy^2 = -1 if negative is true. Returns QUADRATIC_NONE if there is
+// none, and QUADRATIC_TOO_LONG if the period of sqrt(D) is too long.
+int solve_pell(int D, bool negative, bigint &x, bigint &y) {
+    // sqrt(D) = [a0; (a1, ..., a_r)] where a_r = 2 a0, and the convergent
+    // just before the end of the first period has p^2 - Dq^2 = (-1)^r.
+    int_v terms;
+    size_t preperiod;
+    int status = quadratic_cont_frac(0, D, 1, terms, preperiod);
+    if (status != QUADRATIC_FOUND) {
+        return status;
+    }
+    size_t period = terms.size() - preperiod;
+    if (negative && period % 2 == 0) {
+        return QUADRATIC_NONE;
+    }
+
+    // p and q are the first column of the product of the term matrices.
+    bigint m[4];
+    term_matrix_product(terms, 0, terms.size() - 1, m);
+    x = m[0];
+    y = m[2];
+
+    // An odd period gives a solution to -1, and its square solves 1.
+    if (!negative && period % 2 == 1) {
+        pell_power(D, m[0], m[2], 2, x, y);
+    }
+    return QUADRATIC_FOUND;
+}
+
+
+// Finds (x + y sqrt(D))^n = x_n + y_n sqrt(D) by repeated squaring, which
+// gives the nth solution of Pell's equation from the first.
+void pell_power(int D, const bigint &x, const bigint &y, int n, bigint &x_n,
+bigint &y_n) {
+    bigint big_D = bigint_from_int(D);
+    bigint base_x = x;
+    bigint base_y = y;
+    x_n = bigint_from_int(1);
+    y_n = bigint_from_int(0);
+
+    // (a + b sqrt(D))(c + d sqrt(D)) = (ac + bdD) + (ad + bc) sqrt(D).
+    while (n > 0) {
+        if (n & 1) {
+            bigint next_x = bigint_add(bigint_mul(x_n, base_x),
+            bigint_mul(bigint_mul(y_n, base_y), big_D));
+            y_n = bigint_add(bigint_mul(x_n, base_y), bigint_mul(y_n, base_x));
+            x_n = std::move(next_x);
+        }
+        n >>= 1;
+        if (n > 0) {
+            bigint next_x = bigint_add(bigint_mul(base_x, base_x),
+            bigint_mul(bigint_mul(base_y, base_y), big_D));
+            base_y = bigint_mul_small(bigint_mul(base_x, base_y), 2);
+            base_x = std::move(next_x);
+        }
+    }
+    return;
+}
+
+
+// Reads P, D and Q for a quadratic irrational (P + sqrt(D)) / Q from user.
+void take_input_quadratic(int &P, int &D, int &Q) {
+    std::cerr << "This finds the continued fraction of (P + sqrt(D)) / Q.\n\n";
+    std::cerr << "Enter P: ";
+    if (!(std::cin >> P)) {
+        std::cerr << RED << "Error reading P." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cerr << "Enter D: ";
+    if (!(std::cin >> D) || D <= 0) {
+        std::cerr << RED << "Error: D must be positive." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cerr << "Enter Q: ";
+    if (!(std::cin >> Q) || Q == 0) {
+        std::cerr << RED << "Error: Q must not be 0." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return;
+}
+
+
+// Prints limitations for Pell's equation.
+void print_limitations_pell(void) {
+    std::cerr << "Limitations:\n";
+
+    std::cerr << "- D must be 1 to 10^18.\n";
+    std::cerr << "- The period of sqrt(D) must have at most ";
+    std::cerr << MAX_QUADRATIC_TERMS << " terms.\n";
+    std::cerr << "- At most solution " << MAX_PELL_INDEX << " can be found, ";
+    std::cerr << "as each one is longer than the last.\n\n";
+
+    return;
+}
+
+
+// Reads D, the sign of the right hand side and which solution to find for
+// Pell's equation from user.
+void take_input_pell(int &D, bool &negative, int &n) {
+    std::cerr << "This solves x^2 - Dy^2 = 1 or x^2 - Dy^2 = -1.\n\n";
+    std::cerr << "Enter D: ";
+    if (!(std::cin >> D) || D <= 0 || D > MAX_QUADRATIC_D) {
+        std::cerr << RED << "Error: D must be 1 to 10^18." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    int sign;
+    std::cerr << "Enter right hand side (1 or -1): ";
+    if (!(std::cin >> sign) || (sign != 1 && sign != -1)) {
+        std::cerr << RED << "Error: right hand side must be 1 or -1." << RESET;
+        std::cerr << "\n";
+        exit(EXIT_FAILURE);
+    }
+    negative = sign == -1;
+
+    std::cerr << "Enter which solution to find (1 is the smallest): ";
+    if (!(std::cin >> n) || n <= 0 || n > MAX_PELL_INDEX) {
+        std::cerr << RED << "Error: solution number must be 1 to ";
+        std::cerr << MAX_PELL_INDEX << "." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return;
+}
+
+
+// Sets up a source of the terms of (P + sqrt(D)) / Q, where D may be a perfect
+// square or 0. Returns false if Q is 0, D is negative, or the numbers are more
+// than 10^18.
+bool init_cf_source(cf_source &source, int P, int D, int Q) {
+    if (Q == 0 || D < 0 || D > MAX_QUADRATIC_D || std::abs(P) > MAX_QUADRATIC_D
+    || std::abs(Q) > MAX_QUADRATIC_D) {
+        return false;
+    }
+
+    source.done = false;
+    source.root = integer_sqrt(D);
+    source.quadratic = source.root * source.root != D;
+    source.P = P;
+    source.D = D;
+    source.Q = Q;
+    if (source.quadratic) {
+        bool valid = normalise_quadratic(source.P, source.D, source.Q);
+        source.root = integer_sqrt(source.D);
+        return valid;
+    }
+
+    // A rational number, with the denominator kept positive for the Euclidean
+    // algorithm.
+    source.P = Q > 0 ? P + source.root : -(P + source.root);
+    source.Q = std::abs(Q);
+    source.D = 0;
+    return true;
+}
+
+
+// Sets term to the next term of a source. Returns false once there are none.
+bool next_cf_term(cf_source &source, int &term) {
+    if (source.done) {
+        return false;
+    } else if (source.quadratic) {
+        term = quadratic_step(source.P, source.Q, source.D, source.root);
+        return true;
+    }
+
+    // One step of the Euclidean algorithm on P / Q.
+    term = floor_div(source.P, source.Q);
+    int remainder = source.P - term * source.Q;
+    source.P = source.Q;
+    source.Q = remainder;
+    source.done = remainder == 0;
+    return true;
+}
+
+
+// Replaces x with term + 1 / x in the coefficients m of one side of the
+// transform. After the last term x is infinite, so only the coefficients of x
+// matter, and they become the coefficients of y and the constant.
+static void substitute_x(bigint m[4], const bigint &term, bool last) {
+    bigint with_y = bigint_add(bigint_mul(m[0], term), m[2]);
+    bigint constant = bigint_add(bigint_mul(m[1], term), m[3]);
+    if (last) {
+        m[0] = bigint_from_int(0);
+        m[1] = bigint_from_int(0);
+    } else {
+        m[2] = std::move(m[0]);
+        m[3] = std::move(m[1]);
+    }
+    m[last ? 2 : 0] = std::move(with_y);
+    m[last ? 3 : 1] = std::move(constant);
+    return;
+}
+
+
+// Replaces y with term + 1 / y in the coefficients m of one side of the
+// transform, in the same way as substitute_x.
+static void substitute_y(bigint m[4], const bigint &term, bool last) {
+    bigint with_x = bigint_add(bigint_mul(m[0], term), m[1]);
+    bigint constant = bigint_add(bigint_mul(m[2], term), m[3]);
+    if (last) {
+        m[0] = bigint_from_int(0);
+        m[2] = bigint_from_int(0);
+    } else {
+        m[1] = std::move(m[0]);
+        m[3] = std::move(m[2]);
+    }
+    m[last ? 1 : 0] = std::move(with_x);
+    m[last ? 3 : 2] = std::move(constant);
+    return;
+}
+
+
+// Reads the next term of x or y into the transform.
+static void gosper_read(gosper_state &state, bool from_x) {
+    cf_source &source = from_x ? state.x : state.y;
+    int value = 0;
+    next_cf_term(source, value);
+    bigint term = bigint_from_int(value);
+    if (from_x) {
+        substitute_x(state.n, term, source.done);
+        substitute_x(state.d, term, source.done);
+    } else {
+        substitute_y(state.n, term, source.done);
+        substitute_y(state.d, term, source.done);
+    }
+    ++state.idle;
+    return;
+}
+
+
+// Sets up Gosper's algorithm for x op y, where op is '+', '-', '*' or '/'.
+// Returns false for any other op.
+bool init_gosper(gosper_state &state, char op, const cf_source &x,
+const cf_source &y) {
+    // The coefficients of xy, x, y and 1 in the numerator and denominator.
+    int n[4] = {0, 1, 1, 0};
+    int d[4] = {0, 0, 0, 1};
+    if (op == '-') {
+        n[2] = -1;
+    } else if (op == '*') {
+        n[0] = 1;
+        n[1] = 0;
+        n[2] = 0;
+    } else if (op == '/') {
+        n[2] = 0;
+        d[2] = 1;
+        d[3] = 0;
+    } else if (op != '+') {
+        return false;
+    }
+
+    for (size_t index = 0; index < 4; ++index) {
+        state.n[index] = bigint_from_int(n[index]);
+        state.d[index] = bigint_from_int(d[index]);
+    }
+    state.x = x;
+    state.y = y;
+    state.read_x_next = true;
+    state.emitted = 0;
+
+    // The rest of a continued fraction after its first term is more than 1,
+    // which the bounds in next_gosper_term rely on. The first terms can be
+    // anything, so read them straight away.
+    gosper_read(state, true);
+    gosper_read(state, false);
+    state.idle = 0;
+    return true;
+}
+
+
+// Finds the next term of the result, reading terms of x and y only as needed.
+// Returns GOSPER_TERM with the term, GOSPER_END after the last term,
+// GOSPER_UNDEFINED when dividing by zero, or GOSPER_UNDECIDED if
+// MAX_IDLE_TERMS input terms in a row did not settle the next term.
+int next_gosper_term(gosper_state &state, bigint &term) {
+    while (true) {
+        // A zero denominator means the rest of the result is infinite, which
+        // ends it. Before any terms it means the result is undefined.
+        bool infinite = true;
+        for (size_t index = 0; index < 4; ++index) {
+            infinite = infinite && bigint_is_zero(state.d[index]);
+        }
+        if (infinite) {
+            return state.emitted == 0 ? GOSPER_UNDEFINED : GOSPER_END;
+        }
+
+        // With the rest of x and y anywhere from 0 to infinity, z lies between
+        // its values at the corners n[i] / d[i]. Corners for an input that has
+        // ended have all their coefficients at 0 and are skipped. The term is
+        // known once no denominator changes sign and every corner has the
+        // same floor.
+        bool x_live = !state.x.done;
+        bool y_live = !state.y.done;
+        bool live[4] = {x_live && y_live, x_live, y_live, true};
+        bool decided = true;
+        bool first = true;
+        bool negative = false;
+        for (size_t index = 0; index < 4; ++index) {
+            if (!live[index]) {
+                continue;
+            } else if (bigint_is_zero(state.d[index])
+            || (!first && state.d[index].negative != negative)) {
+                decided = false;
+                break;
+            }
+
+            bigint corner = bigint_floor_div(state.n[index], state.d[index]);
+            if (first) {
+                term = std::move(corner);
+                negative = state.d[index].negative;
+                first = false;
+            } else if (bigint_compare(corner, term) != 0) {
+                decided = false;
+                break;
+            }
         }
 
-        // Print error bound.
-        std::cout << "The error bound for";
-        std::cout << " this is 1 / ";
-        std::cout << calculate_error_bound(q, x, index) << "\n\n";
+        // z = term + 1 / z', so z' = d / (n - term * d).
+        if (decided) {
+            for (size_t index = 0; index < 4; ++index) {
+                bigint rest = bigint_sub(state.n[index],
+                bigint_mul(term, state.d[index]));
+                state.n[index] = std::move(state.d[index]);
+                state.d[index] = std::move(rest);
+            }
+            state.idle = 0;
+            ++state.emitted;
+            return GOSPER_TERM;
+        } else if (state.idle >= MAX_IDLE_TERMS) {
+            return GOSPER_UNDECIDED;
+        }
+
+        // Take turns reading x and y, so that neither is left behind.
+        bool from_x = x_live && (!y_live || state.read_x_next);
+        state.read_x_next = !from_x;
+        gosper_read(state, from_x);
     }
 }
 
 
-// Finds the error bound of convergent i.
-int calculate_error_bound(int_v q, int_v x, size_t i) {
-    // Take the next quotient and the square of the current value of x.
-    int next_quotient = q[i + 1];
-    int x_squared = x[i + 2] * x[i + 2];
-    return (next_quotient * x_squared);
+// Reads P, D and Q for one operand of continued fraction arithmetic.
+static void take_input_operand(const char *name, int operand[3]) {
+    std::cerr << "Enter P for " << name << ": ";
+    if (!(std::cin >> operand[0])) {
+        std::cerr << RED << "Error reading P." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cerr << "Enter D for " << name << " (0 for P / Q): ";
+    if (!(std::cin >> operand[1]) || operand[1] < 0) {
+        std::cerr << RED << "Error: D must not be negative." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cerr << "Enter Q for " << name << ": ";
+    if (!(std::cin >> operand[2]) || operand[2] == 0) {
+        std::cerr << RED << "Error: Q must not be 0." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return;
 }
 
 
-// Prints messages about where the program stopped printing convergents.
-void print_convergent_stop(int stop_point) {
-    // Print to stdout.
-    std::cout << RED << "Program terminated to prevent integer ";
-    std::cout << "overflow." << RESET << "\n";
+// Reads two operands (P + sqrt(D)) / Q, an operation and how many terms of
+// the result to print from user.
+void take_input_cf_arithmetic(int x[3], int y[3], char &op, int &count) {
+    std::cerr << "This finds x + y, x - y, x * y or x / y as a continued ";
+    std::cerr << "fraction, where x and y are (P + sqrt(D)) / Q.\n\n";
+    take_input_operand("x", x);
+    take_input_operand("y", y);
 
-    // Print the point where the program stopped,
-    std::cout << "\nConvergent " << stop_point << " not printed.\n";
+    std::cerr << "Enter the operation (+, -, * or /): ";
+    if (!(std::cin >> op) || (op != '+' && op != '-' && op != '*'
+    && op != '/')) {
+        std::cerr << RED << "Error: unknown operation." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
 
-    // Print same error message to stderr.
-    std::cerr << "\n" << RED << "Program terminated to prevent integer";
-    std::cerr << " overflow." << RESET << "\n\n";
+    std::cerr << "Enter the number of terms to print: ";
+    if (!(std::cin >> count) || count <= 0) {
+        std::cerr << RED << "Error: invalid number of terms." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
 
     return;
 }
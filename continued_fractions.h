@@ -2,7 +2,7 @@
 Header file for continued fraction functions.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -12,6 +12,7 @@ Last updated 19 August 2022.
 
 #include <iostream>
 #include <vector>
+#include "bigint.h"
 #include "debug.h"
 #include "euclidean.h"
 
@@ -19,13 +20,85 @@ Last updated 19 August 2022.
 #define int long long
 #define int_v std::vector<long long>
 
-#define MAX_INPUT 1e8
+#define MAX_INPUT 1e8 // Larger inputs use big integers and skip the table.
+#define MAX_QUADRATIC_D 1000000000000000000 // 10^18, after clearing Q.
+#define MAX_CF_TERMS    1000000 // Most result terms in one batch job.
+#define MAX_IDLE_TERMS  2000 // Input terms read with no output at most.
+#define MAX_QUADRATIC_TERMS 1000000 // Most terms before and in one period.
+#define MAX_PELL_INDEX  10000 // Largest solution number n for Pell's equation.
+
+#define GOSPER_TERM      0 // Return values of next_gosper_term().
+#define GOSPER_END       1
+#define GOSPER_UNDECIDED 2
+#define GOSPER_UNDEFINED 3
+
+#define QUADRATIC_FOUND    0 // Return values of quadratic_cont_frac() and
+#define QUADRATIC_NONE     1 // solve_pell().
+#define QUADRATIC_TOO_LONG 2
 
 #define RED    "\033[31m"
 #define RESET  "\033[0m"
 #define YELLOW "\033[33m"
 
 
+// The last two convergents p / q of a continued fraction, for the recurrence
+// p_k = a_k p_(k-1) + p_(k-2), and likewise for q_k.
+typedef struct big_convergent {
+    bigint p;
+    bigint q;
+    bigint p_prev;
+    bigint q_prev;
+} big_convergent;
+
+
+// A convergent generator for n / d. It runs the Euclidean algorithm one
+// quotient ahead of the convergent p / q, so that the error bound
+// 1 / (a_(k+1) q_k^2) is known as soon as the convergent is. bound is 0 for
+// the last convergent, which is n / d itself.
+typedef struct convergent_stream {
+    int n;
+    int d;
+    int next_quotient;
+    bool has_next;
+    int p;
+    int q;
+    int p_prev;
+    int q_prev;
+    uint128 bound;
+} convergent_stream;
+
+
+// A source of continued fraction terms for (P + sqrt(D)) / Q. If D is a
+// perfect square the value is the rational number P / Q, and the terms come
+// from the Euclidean algorithm. Otherwise they come from quadratic_step, so
+// the terms never run out. Either way only the current P and Q are kept.
+typedef struct cf_source {
+    bool quadratic;
+    bool done;
+    int P;
+    int D;
+    int Q;
+    int root;
+} cf_source;
+
+
+// Gosper's bihomographic transform
+// z = (n[0] xy + n[1] x + n[2] y + n[3]) / (d[0] xy + d[1] x + d[2] y + d[3])
+// for continued fractions x and y, which reads terms of x and y only until the
+// next term of z is known. No terms are stored. If x or y is rational the
+// coefficients stay small, but with two irrationals they grow by a few bits
+// for each term of z.
+typedef struct gosper_state {
+    bigint n[4];
+    bigint d[4];
+    cf_source x;
+    cf_source y;
+    bool read_x_next;
+    int idle;
+    int emitted;
+} gosper_state;
+
+
 // The main code that converts a fraction into a continued fraction
 // representation.
 int do_convert_cont_frac(void);
@@ -36,6 +109,24 @@ int do_convert_cont_frac(void);
 int do_cont_frac_convergents(void);
 
 
+// The main code that finds the best approximation to a fraction with a
+// bounded denominator.
+int do_best_approximation(void);
+
+
+// The main code that finds the continued fraction of (P + sqrt(D)) / Q.
+int do_quadratic_cont_frac(void);
+
+
+// The main code that solves Pell's equation x^2 - Dy^2 = 1 or -1.
+int do_solve_pell(void);
+
+
+// The main code that adds, subtracts, multiplies or divides two continued
+// fractions.
+int do_cf_arithmetic(void);
+
+
 // Prints limitations for continued fraction conversion.
 void print_limitations_cf_convert(void);
 
@@ -49,8 +140,34 @@ void print_limitations_cf_converge(void);
 void auto_cont_frac(int n, int d, int_v &q, int_v &r, int_v &x, int_v &y);
 
 
-// Reads numerator and denominator fron user.
-void take_input_cf_convert(int &num, int &den);
+// Reads numerator and denominator of any size from user.
+void take_input_cf_convert(bigint &num, bigint &den);
+
+
+// Returns whether a fraction is small enough to show the table of working.
+bool fits_cf_table(const bigint &num, const bigint &den);
+
+
+// Finds the quotients of the continued fraction of n / d, for n and d of any
+// size.
+void big_cont_frac(bigint n, bigint d, std::vector<bigint> &quotients);
+
+
+// Prints a continued fraction with quotients of any size.
+void print_big_cont_frac(const std::vector<bigint> &quotients);
+
+
+// Starts the convergent recurrence before the first quotient.
+void init_big_convergent(big_convergent &convergent);
+
+
+// Moves to the next convergent, given the next quotient.
+void next_big_convergent(big_convergent &convergent, const bigint &quotient);
+
+
+// Prints every convergent of a continued fraction with quotients of any size,
+// and its error bound.
+void print_big_convergents(const std::vector<bigint> &quotients);
 
 
 // Prints a continued fraction when given a vector containing quotients from
@@ -58,20 +175,106 @@ void take_input_cf_convert(int &num, int &den);
 void print_cont_frac(int_v quotients);
 
 
-// Returns the absolute value of the input.
-int absolute_val(int input);
+// Starts a convergent generator for n / d, with n >= 0 and d > 0.
+void init_convergent_stream(convergent_stream &stream, int n, int d);
+
+
+// Moves to the next convergent and its error bound. Returns false once every
+// convergent has been generated. Nothing is stored, so each step is one
+// division and a few multiplications.
+bool next_convergent(convergent_stream &stream);
+
+
+// Writes the current convergent of a stream and its error bound, as convergent
+// number index.
+str format_stream_convergent(const convergent_stream &stream, int index);
+
+
+// Prints limitations for best approximations.
+void print_limitations_best(void);
+
+
+// Reads a fraction and the largest denominator allowed from user.
+void take_input_best(int &num, int &den, int &limit);
+
+
+// Returns the largest integer whose square is at most n, for n >= 0.
+int integer_sqrt(int n);
+
+
+// Finds the continued fraction of (P + sqrt(D)) / Q, which is eventually
+// periodic. terms holds the terms before the period and then one period,
+// which starts at index preperiod. Returns QUADRATIC_NONE if D is a perfect
+// square, Q is 0, or the numbers are too large, and QUADRATIC_TOO_LONG if
+// there are more than MAX_QUADRATIC_TERMS terms up to the end of the period.
+int quadratic_cont_frac(int P, int D, int Q, int_v &terms, size_t &preperiod);
+
+
+// Writes a periodic continued fraction with the period in brackets, so
+// sqrt(7) is [2; (1, 1, 1, 4)].
+str format_quadratic_cf(const int_v &terms, size_t preperiod);
+
+
+// Finds the smallest positive solution of x^2 - Dy^2 = 1, or of
+// x^2 - Dy^2 = -1 if negative is true. Returns QUADRATIC_NONE if there is
+// none, and QUADRATIC_TOO_LONG if the period of sqrt(D) is too long.
+int solve_pell(int D, bool negative, bigint &x, bigint &y);
+
+
+// Finds (x + y sqrt(D))^n = x_n + y_n sqrt(D) by repeated squaring, which
+// gives the nth solution of Pell's equation from the first.
+void pell_power(int D, const bigint &x, const bigint &y, int n, bigint &x_n,
+bigint &y_n);
+
+
+// Reads P, D and Q for a quadratic irrational (P + sqrt(D)) / Q from user.
+void take_input_quadratic(int &P, int &D, int &Q);
+
+
+// Prints limitations for Pell's equation.
+void print_limitations_pell(void);
+
+
+// Reads D, the sign of the right hand side and which solution to find for
+// Pell's equation from user.
+void take_input_pell(int &D, bool &negative, int &n);
+
+
+// Finds p / q closest to n / d with q at most limit, choosing the smaller q on
+// a tie. Runs the Euclidean algorithm only until the convergents pass the
+// limit, then picks between the last convergent and the best semiconvergent,
+// so it takes O(log limit) steps and allocates nothing.
+void best_approximation(int n, int d, int limit, int &p, int &q);
+
+
+// Sets up a source of the terms of (P + sqrt(D)) / Q, where D may be a perfect
+// square or 0. Returns false if Q is 0, D is negative, or the numbers are more
+// than 10^18.
+bool init_cf_source(cf_source &source, int P, int D, int Q);
+
+
+// Sets term to the next term of a source. Returns false once there are none.
+bool next_cf_term(cf_source &source, int &term);
 
 
-// Prints convergents.
-void print_convergents(int_v q, int_v x, int_v y);
+// Sets up Gosper's algorithm for x op y, where op is '+', '-', '*' or '/'.
+// Returns false for any other op.
+bool init_gosper(gosper_state &state, char op, const cf_source &x,
+const cf_source &y);
 
 
-// Finds the error bound of convergent i.
-int calculate_error_bound(int_v q, int_v x, size_t i);
+// Finds the next term of the result, reading terms of x and y only as needed.
+// Returns GOSPER_TERM with the term, GOSPER_END after the last term,
+// GOSPER_UNDEFINED when dividing by zero, or GOSPER_UNDECIDED if
+// MAX_IDLE_TERMS input terms in a row did not settle the next term. That
+// happens when the exact result is rational but x and y are not, such as
+// sqrt(2) * sqrt(2), and the result sits on a boundary between terms forever.
+int next_gosper_term(gosper_state &state, bigint &term);
 
 
-// Prints messages about where the program stopped printing convergents.
-void print_convergent_stop(int stop_point);
+// Reads two operands (P + sqrt(D)) / Q, an operation and how many terms of
+// the result to print from user.
+void take_input_cf_arithmetic(int x[3], int y[3], char &op, int &count);
 
 
 #endif
@@ -2,7 +2,7 @@
 Implementation of Chinese remainder theorem functions.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -20,35 +20,54 @@ int do_crt_congruences(void) {
         exit(EXIT_FAILURE);
     }
 
-    // Read constants and moduli from user.
+    // Read coefficients, constants and moduli from user.
+    int_vec coeffs;
     int_vec moduli;
     int_vec constants;
-    take_input_crt(constants, moduli, congruence_count);
+    take_input_crt(coeffs, constants, moduli, congruence_count);
+
+    // Check each congruence on its own first, so that the error can say which
+    // one has no solution.
+    for (size_t index = 0; index < moduli.size(); ++index) {
+        if (moduli[index] <= 0) {
+            std::cerr << RED << "Error: moduli must be positive." << RESET;
+            std::cerr << "\n";
+            return EXIT_FAILURE;
+        }
 
-    // Check that moduli are pairwise coprime.
-    int product = calculate_product(moduli);
-    if (product < 0) {
-        // calculate_product() returned negative value so an error occurred.
-        return EXIT_FAILURE;
+        int k;
+        int new_mod;
+        if (!reduce_linear_congruence(coeffs[index], constants[index],
+        moduli[index], k, new_mod)) {
+            std::cerr << RED << "Error: congruence " << index + 1 << " has no ";
+            std::cerr << "solution." << RESET << "\n";
+            return EXIT_FAILURE;
+        }
     }
 
-    int lcm = calculate_lcm(moduli);
-    if (lcm != product) {
-        // Moduli not pairwise coprime.
-        int solution = handle_not_coprime(constants, moduli, lcm);
-        if (solution >= 0) {
-            std::cout << "\nSolution: x = " << solution << " (mod " << lcm;
-            std::cout << ")\n\n";
-        }
-    } else {
-        // Moduli are pairwise coprime.
-        int solution = handle_coprime(constants, moduli, product);
-        if (solution >= 0) {
-            std::cout << "\nSolution: x = " << solution << " (mod " << lcm;
-            std::cout << ")\n\n";
-        }
+    // Merge the congruences one at a time, as the batch jobs do. Systems whose
+    // LCM does not fit in 64 bits are solved again with big integers.
+    int solution;
+    int modulus;
+    int status = solve_linear_system(coeffs, constants, moduli, solution,
+    modulus);
+    if (status == CRT_SOLVED) {
+        std::cout << "\nSolution: x = " << solution << " (mod " << modulus;
+        std::cout << ")\n\n";
+        return 0;
+    }
+
+    bigint big_solution;
+    bigint big_modulus;
+    size_t threads = std::thread::hardware_concurrency();
+    if (status == CRT_OVERFLOW && solve_big_linear_system(coeffs, constants,
+    moduli, big_solution, big_modulus, threads)) {
+        std::cout << "\nSolution: x = " << bigint_to_string(big_solution);
+        std::cout << " (mod " << bigint_to_string(big_modulus) << ")\n\n";
+        return 0;
     }
-    
+
+    std::cout << "\nThere is no solution.\n\n";
     return 0;
 }
 
@@ -58,8 +77,9 @@ void print_limitations_crt(void) {
     std::cerr << "Limitations:\n";
 
     std::cerr << "- Only works for systems where all congruences are of the ";
-    std::cerr << "form 'x = k (mod m)'.\n";
-    std::cerr << "- Limited protection from integer overflow.\n";
+    std::cerr << "form 'ax = b (mod m)'.\n";
+    std::cerr << "- Moduli need not be pairwise coprime. Solutions whose ";
+    std::cerr << "modulus does not fit in 64 bits use big integers.\n";
     std::cerr << "- Not giving enough input may cause segmentation faults, ";
     std::cerr << "memory leaks, or other memory errors.\n\n";
 
@@ -67,15 +87,56 @@ void print_limitations_crt(void) {
 }
 
 
-// Reads input for CRT.
-void take_input_crt(int_vec &constants, int_vec &moduli, int count) {
-    std::cerr << "Equations must be in the form x = k (mod m).\n";
-    std::cerr << "Enter pairs of constants k and moduli m:\n";
+// The main code that solves many systems of linear congruences read from a
+// file.
+int do_crt_batch(void) {
+    std::cerr << "Each system in the file is a count n followed by n triples ";
+    std::cerr << "a b m,\none for each congruence ax = b (mod m). One line is ";
+    std::cerr << "printed per system.\n\n";
+
+    // Read the file name and open the file.
+    str file_name;
+    std::cerr << "Enter path to file: ";
+    if (!(std::cin >> file_name)) {
+        std::cerr << RED << "Error reading file name." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+    std::ifstream input(file_name);
+    if (!input.is_open()) {
+        std::cerr << RED << "Error: could not open '" << file_name << "'.";
+        std::cerr << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    int count = solve_crt_stream(input, std::cout);
+    if (count < 0) {
+        std::cerr << RED << "Error: malformed system in '" << file_name;
+        std::cerr << "'." << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << "\nSolved " << count << " systems.\n";
+    return 0;
+}
+
+
+// Reads input for CRT. Each congruence has the form ax = b (mod m).
+void take_input_crt(int_vec &coeffs, int_vec &constants, int_vec &moduli,
+int count) {
+    std::cerr << "Equations must be in the form ax = b (mod m).\n";
+    std::cerr << "Enter triples of coefficients a, constants b and moduli m:\n";
+    int coeff;
     int modulus;
     int constant;
 
-    // Read constants and moduli from input.
+    // Read coefficients, constants and moduli from input.
     for (int i = 0; i < count; ++i) {
+        if (std::cin >> coeff) {
+            coeffs.push_back(coeff);
+        } else {
+            std::cerr << RED << "Error: insufficient input." << RESET << "\n";
+        }
+
         if (std::cin >> constant) {
             constants.push_back(constant);
         } else {
@@ -91,10 +152,9 @@ void take_input_crt(int_vec &constants, int_vec &moduli, int count) {
 
     // Check that the user has entered in enough numbers.
     size_t count_check = count;
-    if (constants.size() < count_check || moduli.size() < count_check) {
+    if (coeffs.size() < count_check || constants.size() < count_check
+    || moduli.size() < count_check) {
         std::cerr << RED << "Error: insufficient input." << RESET << "\n";
-        constants.~vector();
-        moduli.~vector();
         exit (EXIT_FAILURE);
     }
 
@@ -102,176 +162,409 @@ void take_input_crt(int_vec &constants, int_vec &moduli, int count) {
 }
 
 
-// Calcuates LCM of all items in a vector.
-int calculate_lcm(int_vec v) {
-    // Push moduli onto a stack.
-    int_stack mod_stack;
+// Uses Euclidean algorithm to find GCD.
+int gcd(int a, int b) {
+    int remainder;
+
+    // First iteration.
+    remainder = a % b;
+
+    // Keep iterating until remainder is zero.
+    while (remainder != 0) {
+        a = b;
+        b = remainder;
+        remainder = a % b;
+    }
+
+    return b;
+}
 
-    for (int value : v) {
-        mod_stack.push(value);
+
+// Returns the inverse of a modulo m, or -1 if gcd(a, m) is not 1.
+int mod_inverse(int a, int m) {
+    if (m == 1) {
+        return 0;
     }
 
-    // Keep going until there are fewer than 2 elements left in the stack.
-    while (mod_stack.size() >= 2) {
-        int num1 = mod_stack.top();
-        mod_stack.pop();
-        int num2 = mod_stack.top();
-        mod_stack.pop();
+    // Extended Euclidean algorithm keeping only the x coefficients. These stay
+    // bounded by m, so 64-bit moduli cannot overflow.
+    int old_r = a % m < 0 ? a % m + m : a % m;
+    int r = m;
+    int old_x = 1;
+    int x = 0;
+    while (r != 0) {
+        int quotient = old_r / r;
+        int temp = old_r - quotient * r;
+        old_r = r;
+        r = temp;
+        temp = old_x - quotient * x;
+        old_x = x;
+        x = temp;
+    }
 
-        mod_stack.push((num1 * num2) / gcd(num1, num2));
+    if (old_r != 1) {
+        return -1;
     }
+    return old_x < 0 ? old_x + m : old_x;
+}
+
 
-    return mod_stack.top();
+// Returns base^exponent mod m for a non-negative exponent and positive m.
+int mod_pow(int base, int exponent, int m) {
+    mod_context context;
+    init_mod_context(context, m);
+    uint64_t power = to_mod_form(context, base % m < 0 ? base % m + m
+    : base % m);
+    return from_mod_form(context, mod_pow(context, power, exponent));
 }
 
 
-// Calculates the product of all items in a vector.
-int calculate_product(int_vec v) {
-    int product = 1;
-    for (int value : v) {
-        if (log10(product) + log10(value) > 18) {
-            // Product and value will be larger than 10^18 when multiplied.
-            std::cerr << RED << "Error: integer overflow in calculating ";
-            std::cerr << "product of moduli." << RESET << "\n";
-            return -1;
+// Returns the smallest k > 0 with a^k = 1 (mod m), for a coprime to m. Uses the
+// prime factors of phi(m) rather than trying every k.
+int multiplicative_order(int a, int m) {
+    // The order divides phi(m), so start there and divide out each prime
+    // factor for as long as a^(order / p) is still 1.
+    int phi = m;
+    for (int prime : distinct_prime_factors(m)) {
+        phi = phi / prime * (prime - 1);
+    }
+
+    // Every power is taken modulo the same m, so set up its context once.
+    mod_context context;
+    init_mod_context(context, m);
+    uint64_t base = to_mod_form(context, a % m < 0 ? a % m + m : a % m);
+    int order = phi;
+    for (int prime : distinct_prime_factors(phi)) {
+        while (order % prime == 0
+        && mod_pow(context, base, order / prime) == context.one) {
+            order /= prime;
         }
+    }
+    return order;
+}
+
 
-        product *= value;
+// Runs task(index) for every index in [0, count), spread across threads.
+static void parallel_for(size_t count, size_t threads,
+const std::function<void(size_t)> &task) {
+    if (threads <= 1 || count <= 1) {
+        for (size_t index = 0; index < count; ++index) {
+            task(index);
+        }
+        return;
     }
 
-    return product;
+    // Workers claim indices one at a time, so uneven nodes balance out.
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t index = next++; index < count; index = next++) {
+            task(index);
+        }
+    };
 
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < std::min(threads, count); ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+    return;
 }
 
 
-// Uses Euclidean algorithm to find GCD.
-int gcd(int a, int b) {
-    int remainder;
+// Solves x = c_i (mod m_i) for pairwise coprime moduli by combining residues
+// pairwise up a balanced product tree, with each tree level spread across
+// threads. Stores the solution and the product of the moduli. Returns false
+// if the moduli are not pairwise coprime.
+bool crt_product_tree(const int_vec &c, const int_vec &m, bigint &solution,
+bigint &product, size_t threads) {
+    if (c.size() != m.size() || m.empty()) {
+        std::cerr << RED << "Error: malformed vectors storing constants and ";
+        std::cerr << "moduli for CRT." << RESET << "\n";
+        return false;
+    }
 
-    // First iteration.
-    remainder = a % b;
+    // Product tree. Level 0 holds the moduli and the last level holds their
+    // product M. An unpaired node is carried up unchanged.
+    std::vector<std::vector<bigint>> tree(1);
+    for (int modulus : m) {
+        tree[0].push_back(bigint_from_int(modulus));
+    }
+    while (tree[tree.size() - 1].size() > 1) {
+        const std::vector<bigint> &below = tree[tree.size() - 1];
+        std::vector<bigint> level((below.size() + 1) / 2);
+        parallel_for(level.size(), threads, [&](size_t i) {
+            if (2 * i + 1 < below.size()) {
+                level[i] = bigint_mul(below[2 * i], below[2 * i + 1]);
+            } else {
+                level[i] = below[2 * i];
+            }
+        });
+        tree.push_back(level);
+    }
+    product = tree[tree.size() - 1][0];
+
+    // Remainder tree. Each node holds (M / node product) mod node product, so
+    // each leaf holds (M / m_i) mod m_i. A child's value follows from its
+    // parent's because M / child = (M / parent) * sibling.
+    std::vector<bigint> cofactors(1, bigint_from_int(1));
+    for (size_t depth = tree.size() - 1; depth-- > 0;) {
+        const std::vector<bigint> &nodes = tree[depth];
+        std::vector<bigint> level(nodes.size());
+        parallel_for(level.size(), threads, [&](size_t i) {
+            size_t sibling = i ^ 1;
+            if (sibling >= nodes.size()) {
+                level[i] = cofactors[i / 2];
+                return;
+            }
+            bigint cofactor = bigint_mul(cofactors[i / 2], nodes[sibling]);
+            level[i] = bigint_mod(cofactor, nodes[i]);
+        });
+        cofactors.swap(level);
+    }
 
-    // Keep iterating until remainder is zero.
-    while (remainder != 0) {
-        a = b;
-        b = remainder;
-        remainder = a % b;
+    // Weight each residue by the inverse of (M / m_i) mod m_i.
+    std::atomic<bool> coprime(true);
+    std::vector<bigint> values(m.size());
+    parallel_for(m.size(), threads, [&](size_t i) {
+        int cofactor = bigint_mod_uint(cofactors[i], m[i]);
+        int inverse = mod_inverse(cofactor, m[i]);
+        if (inverse < 0) {
+            coprime = false;
+            return;
+        }
+        int residue = c[i] % m[i] < 0 ? c[i] % m[i] + m[i] : c[i] % m[i];
+        uint128 weighted = uint128(residue) * inverse % m[i];
+        values[i] = bigint_from_uint128(weighted);
+    });
+    if (!coprime) {
+        return false;
     }
 
-    return b;
+    // Combine pairwise up the tree: a node's value is the sum of its leaves'
+    // weights times M_node / m_i, so the root holds the sum over all leaves.
+    for (size_t depth = 0; depth + 1 < tree.size(); ++depth) {
+        const std::vector<bigint> &nodes = tree[depth];
+        std::vector<bigint> level(tree[depth + 1].size());
+        parallel_for(level.size(), threads, [&](size_t i) {
+            if (2 * i + 1 < nodes.size()) {
+                level[i] = bigint_add(
+                    bigint_mul(values[2 * i], nodes[2 * i + 1]),
+                    bigint_mul(values[2 * i + 1], nodes[2 * i])
+                );
+            } else {
+                level[i] = values[2 * i];
+            }
+        });
+        values.swap(level);
+    }
+
+    solution = bigint_mod(values[0], product);
+    return true;
 }
 
 
-// Brute forces for a solution. Used when moduli are not pairwise coprime.
-int brute_force(int_vec constants, int_vec moduli, int lcm) {
-    // Start from 0.
-    int test = 0;
-    while (test < lcm) {
-        size_t index = 0;
-        while (index < constants.size()) {
-            // Check if test is solution to each equation.
-            if (test % moduli[index] != constants[index]) {
-                break; // Stop incrementing index.
-            }
-            ++index;
-        }
+// Reduces ax = b (mod m) to x = k (mod m / gcd(a, m)) by dividing through by
+// the GCD and multiplying by the inverse of a. Returns false if there is no
+// solution. Requires m > 0.
+bool reduce_linear_congruence(int a, int b, int m, int &k, int &new_mod) {
+    a = a % m < 0 ? a % m + m : a % m;
+    b = b % m < 0 ? b % m + m : b % m;
 
-        // test is solution to all congruences. Return the solution.
-        if (index == constants.size()) {
-            return test;
-        }
+    // ax = b (mod m) is solvable exactly when gcd(a, m) divides b.
+    int divisor = gcd(a, m);
+    if (b % divisor != 0) {
+        return false;
+    }
 
-        ++test;
+    new_mod = m / divisor;
+    int inverse = mod_inverse(a / divisor, new_mod);
+    k = uint128(b / divisor) * inverse % new_mod;
+    return true;
+}
+
+
+// Merges x = r1 (mod m1) and x = r2 (mod m2), which need not be coprime, into
+// x = r1 (mod m1) with the LCM as the new m1. Returns a CRT_ status code.
+int merge_congruences(int &r1, int &m1, int r2, int m2) {
+    // The congruences agree exactly when gcd(m1, m2) divides r2 - r1.
+    int divisor = gcd(m1, m2);
+    int128 difference = int128(r2) - r1;
+    if (difference % divisor != 0) {
+        return CRT_NO_SOLUTION;
     }
 
-    // If loop finishes without returning a solution, there is no solution.
-    std::cerr << RED << "Error: no solution found." << RESET << "\n";
-    return -1;
+    int128 lcm = int128(m1 / divisor) * m2;
+    if (lcm > MAX_INT_64) {
+        return CRT_OVERFLOW;
+    }
+
+    // x = r1 + m1 * t, where (m1 / g) t = (r2 - r1) / g (mod m2 / g).
+    int step_mod = m2 / divisor;
+    int128 t = difference / divisor % step_mod;
+    if (t < 0) {
+        t += step_mod;
+    }
+    t = t * mod_inverse(m1 / divisor % step_mod, step_mod) % step_mod;
+
+    r1 = (r1 + int128(m1) * t) % lcm;
+    m1 = lcm;
+    return CRT_SOLVED;
 }
 
 
-// Handles the situation where moduli are not pairwise coprime. Uses a brute
-// force approach to solve if possible.
-int handle_not_coprime(int_vec c, int_vec m, int lcm) {
-    // Inform user that moduli are not pairwise coprime.
-    std::cerr << YELLOW << "\nWarning: moduli not pairwise coprime." << RESET;
-    std::cerr << "\n";
+// Solves the system a_i x = b_i (mod m_i) by reducing and merging each
+// congruence in turn. Returns a CRT_ status code.
+int solve_linear_system(const int_vec &a, const int_vec &b, const int_vec &m,
+int &solution, int &modulus) {
+    solution = 0;
+    modulus = 1;
+    for (size_t index = 0; index < m.size(); ++index) {
+        int k;
+        int new_mod;
+        if (m[index] <= 0) {
+            return CRT_NO_SOLUTION;
+        } else if (!reduce_linear_congruence(a[index], b[index], m[index], k,
+        new_mod)) {
+            return CRT_NO_SOLUTION;
+        }
 
-    if (lcm > MAX_BRUTE_FORCE) {
-        // LCM of moduli too large to brute force quickly.
-        std::cerr << RED << "Error: brute force too inefficient for given";
-        std::cerr << " system of congruences." << RESET << "\n";
-        return -1;
+        int status = merge_congruences(solution, modulus, k, new_mod);
+        if (status != CRT_SOLVED) {
+            return status;
+        }
+    }
 
-    } else {
-        // LCM of moduli small enough to quickly give solution with brute force
-        // approach.
-        std::cerr << "Applying brute force approach...\n";
-        int solution = brute_force(c, m, lcm);
-        return solution;
+    return CRT_SOLVED;
+}
+
+
+// Merges x = r2 (mod m2) into x = r1 (mod m1) like merge_congruences, but
+// with r1 and m1 as big integers so the LCM can grow without limit. Requires
+// 0 <= r1 < m1 and 0 <= r2 < m2. Returns false if the congruences disagree.
+bool merge_big_congruences(bigint &r1, bigint &m1, int r2, int m2) {
+    // Everything needed from r1 and m1 is their remainder modulo m2, and
+    // gcd(m1, m2) = gcd(m1 mod m2, m2).
+    int r1_mod = bigint_mod_uint(r1, m2);
+    int m1_mod = bigint_mod_uint(m1, m2);
+    int divisor = gcd(m1_mod, m2);
+    int difference = r2 - r1_mod < 0 ? r2 - r1_mod + m2 : r2 - r1_mod;
+    if (difference % divisor != 0) {
+        return false;
     }
+
+    // x = r1 + m1 * t, where (m1 / g) t = (r2 - r1) / g (mod m2 / g).
+    int step_mod = m2 / divisor;
+    int t = uint128(difference / divisor)
+    * mod_inverse(m1_mod / divisor % step_mod, step_mod) % step_mod;
+    r1 = bigint_add(r1, bigint_mul(m1, bigint_from_int(t)));
+    m1 = bigint_mul(m1, bigint_from_int(step_mod));
+    return true;
 }
 
 
-// Handles the situation where moduli are pairwise coprime. This is the normal
-// application of Chinese remainder theorem.
-int handle_coprime(int_vec c, int_vec m, int product) {
-    // Check that constants and moduli have same size.
-    if (c.size() != m.size()) {
-        std::cerr << RED << "Error: malformed vectors storing constants and ";
-        std::cerr << "moduli for CRT." << RESET << "\n";
-        return -1;
+// Solves the system a_i x = b_i (mod m_i) with big integers, for systems whose
+// LCM does not fit in 64 bits. Pairwise coprime moduli use the product tree on
+// the given number of threads. Otherwise the congruences are merged one at a
+// time with merge_big_congruences(), which divides out common factors.
+// Returns false if there is no solution.
+bool solve_big_linear_system(const int_vec &a, const int_vec &b,
+const int_vec &m, bigint &solution, bigint &modulus, size_t threads) {
+    int_vec k(m.size());
+    int_vec reduced(m.size());
+    for (size_t i = 0; i < m.size(); ++i) {
+        if (m[i] <= 0
+        || !reduce_linear_congruence(a[i], b[i], m[i], k[i], reduced[i])) {
+            return false;
+        }
     }
-    
-    // Store preliminary x results.
-    int_vec prelim_x_results;
-    prelim_x_results.reserve(c.size());
-    
-    // For each modulus m, solve (product / m) = 1 (mod m) and add this solution
-    // to prelim_x_results.
-    for (int modulus : m) {
-        int x_coeff = product / modulus;
-        prelim_x_results.push_back(solve_congruent_to_one(x_coeff, modulus));
+
+    if (!m.empty() && crt_product_tree(k, reduced, solution, modulus,
+    threads)) {
+        return true;
     }
 
-    // Check that constants and preliminary results have same size.
-    if (c.size() != m.size()) {
-        std::cerr << RED << "Error: malformed vectors storing constants and ";
-        std::cerr << "x_i solutions for CRT." << RESET << "\n";
-        return -1;
+    solution = bigint_from_int(0);
+    modulus = bigint_from_int(1);
+    for (size_t i = 0; i < m.size(); ++i) {
+        if (!merge_big_congruences(solution, modulus, k[i], reduced[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Solves the system a_i x = b_i (mod m_i) and sets line to 'x m', or to
+// 'no solution'. Systems whose LCM does not fit in 64 bits are solved again
+// with big integers. Returns false if there is no solution.
+bool solve_system_line(const int_vec &a, const int_vec &b, const int_vec &m,
+str &line) {
+    int solution;
+    int modulus;
+    int status = solve_linear_system(a, b, m, solution, modulus);
+    if (status == CRT_SOLVED) {
+        line = std::to_string(solution) + " " + std::to_string(modulus);
+        return true;
     }
 
-    // Now take preliminary x results and turn it into a general solution.
-    int solution = 0;
-    for (size_t index = 0; index < c.size(); ++index) {
-        int mod = m[index];
-        int x_val = prelim_x_results[index];
-        int c_val = c[index];
-        solution += (product / mod) * x_val * c_val;
+    bigint big_solution;
+    bigint big_modulus;
+    if (status == CRT_OVERFLOW && solve_big_linear_system(a, b, m,
+    big_solution, big_modulus, 1)) {
+        line = bigint_to_string(big_solution) + " "
+        + bigint_to_string(big_modulus);
+        return true;
     }
 
-    return solution % product;
+    line = "no solution";
+    return false;
 }
 
 
-// Solve an equation of the form kx = 1 (mod m) using extended Euclidean
-// algorithm.
-int solve_congruent_to_one(int x_coeff, int mod) {
-    // Vectors to use in extended Euclidean algorithm.
-    int_vec q;
-    int_vec r;
-    int_vec x;
-    int_vec y;
+// Solves every system in a stream, writing one line per system. Each system is
+// a count n followed by n triples a b m. Returns the number of systems read,
+// or -1 if the input is malformed.
+int solve_crt_stream(std::istream &input, std::ostream &output) {
+    input_buffer in;
+    output_buffer out;
+    init_input_buffer(in, input);
+    init_output_buffer(out, output);
+
+    // These buffers are reused for every system, so their storage is only
+    // allocated while the systems keep getting larger.
+    int_vec a;
+    int_vec b;
+    int_vec m;
+    str line;
+
+    int systems = 0;
+    int count;
+    while (read_int(in, count)) {
+        if (count < 0) {
+            flush_output(out);
+            return -1;
+        }
 
-    // Silently run extended Euclidean algorithm, with x_coeff and mod as input.
-    auto_silent_eea(q, r, x, y, x_coeff, mod);
+        a.resize(count);
+        b.resize(count);
+        m.resize(count);
+        for (int i = 0; i < count; ++i) {
+            if (!read_int(in, a[i]) || !read_int(in, b[i])
+            || !read_int(in, m[i])) {
+                flush_output(out);
+                return -1;
+            }
+        }
 
-    // Read off the second to last x value and adjust to make it positive in its
-    // modulus.
-    int solution = x[x.size() - 2];
-    if (solution < 0) {
-        solution += mod;
+        solve_system_line(a, b, m, line);
+        write_str(out, line);
+        write_char(out, '\n');
+        ++systems;
     }
 
-    return solution;
+    flush_output(out);
+    return systems;
 }
@@ -2,7 +2,7 @@
 Header file for Chinese remainder theorem functions.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -10,19 +10,26 @@ Last updated 19 August 2022.
 #define CRT_H
 
 
+#include <atomic>
 #include <cmath>
+#include <functional>
 #include <iostream>
-#include <stack>
+#include <thread>
 #include <vector>
+#include "bigint.h"
+#include "buffered_io.h"
 #include "debug.h"
 #include "euclidean.h"
+#include "modular.h"
+#include "sieve.h"
 
 
 #define int long long
-#define int_stack std::stack<long long>
 #define int_vec std::vector<long long>
 
-#define MAX_BRUTE_FORCE 1e7
+#define CRT_SOLVED      0
+#define CRT_NO_SOLUTION 1
+#define CRT_OVERFLOW    2
 
 #define RED    "\033[31m"
 #define RESET  "\033[0m"
@@ -37,39 +44,84 @@ int do_crt_congruences(void);
 void print_limitations_crt(void);
 
 
-// Reads input for CRT.
-void take_input_crt(int_vec &constants, int_vec &moduli, int count);
+// The main code that solves many systems of linear congruences read from a
+// file.
+int do_crt_batch(void);
 
 
-// Calcuates LCM of all items in a vector.
-int calculate_lcm(int_vec v);
+// Reads input for CRT. Each congruence has the form ax = b (mod m).
+void take_input_crt(int_vec &coeffs, int_vec &constants, int_vec &moduli,
+int count);
 
 
-// Calculates the product of all items in a vector.
-int calculate_product(int_vec v);
+// Reduces ax = b (mod m) to x = k (mod m / gcd(a, m)) by dividing through by
+// the GCD and multiplying by the inverse of a. Returns false if there is no
+// solution. Requires m > 0.
+bool reduce_linear_congruence(int a, int b, int m, int &k, int &new_mod);
+
+
+// Merges x = r1 (mod m1) and x = r2 (mod m2), which need not be coprime, into
+// x = r1 (mod m1) with the LCM as the new m1. Returns a CRT_ status code.
+int merge_congruences(int &r1, int &m1, int r2, int m2);
+
+
+// Solves the system a_i x = b_i (mod m_i) by reducing and merging each
+// congruence in turn. Returns a CRT_ status code.
+int solve_linear_system(const int_vec &a, const int_vec &b, const int_vec &m,
+int &solution, int &modulus);
+
+
+// Merges x = r2 (mod m2) into x = r1 (mod m1) like merge_congruences, but
+// with r1 and m1 as big integers so the LCM can grow without limit. Requires
+// 0 <= r1 < m1 and 0 <= r2 < m2. Returns false if the congruences disagree.
+bool merge_big_congruences(bigint &r1, bigint &m1, int r2, int m2);
+
+
+// Solves the system a_i x = b_i (mod m_i) with big integers, for systems whose
+// LCM does not fit in 64 bits. Pairwise coprime moduli use the product tree on
+// the given number of threads. Otherwise the congruences are merged one at a
+// time with merge_big_congruences(), which divides out common factors.
+// Returns false if there is no solution.
+bool solve_big_linear_system(const int_vec &a, const int_vec &b,
+const int_vec &m, bigint &solution, bigint &modulus, size_t threads);
+
+
+// Solves the system a_i x = b_i (mod m_i) and sets line to 'x m', or to
+// 'no solution'. Systems whose LCM does not fit in 64 bits are solved again
+// with big integers. Returns false if there is no solution.
+bool solve_system_line(const int_vec &a, const int_vec &b, const int_vec &m,
+str &line);
+
+
+// Solves every system in a stream, writing one line per system. Each system is
+// a count n followed by n triples a b m. Returns the number of systems read,
+// or -1 if the input is malformed.
+int solve_crt_stream(std::istream &input, std::ostream &output);
 
 
 // Uses Euclidean algorithm to find GCD.
 int gcd(int a, int b);
 
 
-// Brute forces for a solution. Used when moduli are not pairwise coprime.
-int brute_force(int_vec constants, int_vec moduli, int lcm);
+// Returns the inverse of a modulo m, or -1 if gcd(a, m) is not 1.
+int mod_inverse(int a, int m);
 
 
-// Handles the situation where moduli are not pairwise coprime. Uses a brute
-// force approach to solve if possible.
-int handle_not_coprime(int_vec c, int_vec m, int lcm);
+// Returns base^exponent mod m for a non-negative exponent and positive m.
+int mod_pow(int base, int exponent, int m);
 
 
-// Handles the situation where moduli are pairwise coprime. This is the normal
-// application of Chinese remainder theorem.
-int handle_coprime(int_vec c, int_vec m, int product);
+// Returns the smallest k > 0 with a^k = 1 (mod m), for a coprime to m. Uses the
+// prime factors of phi(m) rather than trying every k.
+int multiplicative_order(int a, int m);
 
 
-// Solve an equation of the form kx = 1 (mod m) using extended Euclidean
-// algorithm.
-int solve_congruent_to_one(int x_coeff, int mod);
+// Solves x = c_i (mod m_i) for pairwise coprime moduli by combining residues
+// pairwise up a balanced product tree, with each tree level spread across
+// threads. Stores the solution and the product of the moduli. Returns false
+// if the moduli are not pairwise coprime.
+bool crt_product_tree(const int_vec &c, const int_vec &m, bigint &solution,
+bigint &product, size_t threads);
 
 
 #endif
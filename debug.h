@@ -2,7 +2,7 @@
 Header file for debugging functions.
 
 Written by Stephen Chuang.
-Last updated 6 July 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -10,11 +10,42 @@ Last updated 6 July 2022.
 #define DEBUG_H
 
 
+// Every header in this program includes this file, so any standard header used
+// anywhere in the program is included here before the macros below. Including
+// a standard header after '#define int long long' breaks it.
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
 #include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
-#include <cstdlib>
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 
 #define str std::string
@@ -25,9 +56,13 @@ Last updated 6 July 2022.
 #define RESET "\033[0m"
 
 
+// 128-bit integers for intermediate products that overflow 64 bits.
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+
 
 // Debugging function that prints the contents of a vector.
 void print_vector(int_vec v);
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,266 @@
+/*
+Implementation of discrete logarithm functions.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#include "discrete_log.h"
+
+
+// The main code that runs the discrete logarithm solver.
+int do_discrete_log(void) {
+    int base;
+    int target;
+    int m;
+    take_input_discrete_log(base, target, m);
+
+    int x;
+    int period;
+    int status = discrete_log(base, target, m, x, period);
+    if (status == DLOG_TOO_LARGE) {
+        std::cerr << RED << "\nError: the order of " << base << " has a prime ";
+        std::cerr << "factor above " << MAX_DLOG_PRIME << "." << RESET << "\n";
+        return EXIT_FAILURE;
+    } else if (status == DLOG_NO_SOLUTION) {
+        std::cout << "\nThere are no solutions.\n\n";
+        return 0;
+    }
+
+    std::cout << "\nSmallest solution: x = " << x << "\n";
+    if (period > 0) {
+        std::cout << "All solutions: x = " << x << " + " << period;
+        std::cout << "k for k >= 0\n\n";
+    } else {
+        std::cout << "Larger solutions, if any, are not periodic from here, ";
+        std::cout << "as " << base << " shares a factor with " << m << ".\n\n";
+    }
+    return 0;
+}
+
+
+// Reads the base, the target and the modulus from the user.
+void take_input_discrete_log(int &base, int &target, int &m) {
+    std::cerr << "Solves b^x = a (mod m) for x.\n";
+    std::cerr << "Enter b, a and m: ";
+    if (!(std::cin >> base >> target >> m)) {
+        std::cerr << RED << "Error reading input." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    } else if (m <= 0) {
+        std::cerr << RED << "Error: m must be positive." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+    return;
+}
+
+
+// Returns the slot a key starts its search from.
+static size_t hash_slot(const bsgs_table &table, uint64_t key) {
+    return (key * HASH_MULTIPLIER) >> table.shift;
+}
+
+
+// Fills the table with the baby steps of generator, which has the given prime
+// order, modulo the modulus of context.
+void init_bsgs_table(bsgs_table &table, const mod_context &context,
+uint64_t generator, uint64_t order) {
+    // Balance the work: about sqrt(order) baby steps and as many giant steps.
+    uint64_t step_count = std::sqrt((double)(order));
+    while (step_count * step_count < order) {
+        ++step_count;
+    }
+
+    // At most half full, so that runs of occupied slots stay short.
+    size_t size = 1;
+    table.shift = 64;
+    while (size < 2 * step_count) {
+        size *= 2;
+        --table.shift;
+    }
+    table.keys.assign(size, EMPTY_SLOT);
+    table.steps.assign(size, 0);
+    table.step_count = step_count;
+    table.order = order;
+
+    // The powers below the order are distinct, so every key is new.
+    uint64_t power = context.one;
+    for (uint64_t step = 0; step < step_count; ++step) {
+        size_t slot = hash_slot(table, power);
+        while (table.keys[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & (size - 1);
+        }
+        table.keys[slot] = power;
+        table.steps[slot] = step;
+        power = mod_mul(context, power, generator);
+    }
+
+    uint64_t inverse = mod_pow(context, generator, order - 1);
+    table.giant = mod_pow(context, inverse, step_count);
+    return;
+}
+
+
+// Finds 0 <= exponent < order with g^exponent = target by baby-step giant-step,
+// for target in the stored form. Returns false if target is not a power of g.
+bool bsgs_search(const bsgs_table &table, const mod_context &context,
+uint64_t target, uint64_t &exponent) {
+    // target * g^(-i * step_count) = g^j gives exponent i * step_count + j.
+    size_t mask = table.keys.size() - 1;
+    uint64_t value = target;
+    for (uint64_t i = 0; i * table.step_count < table.order; ++i) {
+        for (size_t slot = hash_slot(table, value);
+        table.keys[slot] != EMPTY_SLOT; slot = (slot + 1) & mask) {
+            if (table.keys[slot] == value) {
+                exponent = i * table.step_count + table.steps[slot];
+                return exponent < table.order;
+            }
+        }
+        value = mod_mul(context, value, table.giant);
+    }
+    return false;
+}
+
+
+// Finds x mod prime^exponent for base^x = target, where base has the given
+// order, one base-prime digit at a time. Each digit is a logarithm in the
+// subgroup of order prime, which is found by baby-step giant-step. The table
+// is built once and shared by every digit. Returns a DLOG_ status code.
+static int prime_power_log(const mod_context &context, uint64_t base,
+uint64_t target, int order, int prime, int exponent, int &x) {
+    if (prime > MAX_DLOG_PRIME) {
+        return DLOG_TOO_LARGE;
+    }
+
+    bsgs_table table;
+    init_bsgs_table(table, context, mod_pow(context, base, order / prime),
+    prime);
+    uint64_t inverse = mod_pow(context, base, order - 1);
+
+    // (target * base^-x)^(order / prime^(k + 1)) is the subgroup generator to
+    // the power of digit k, once x holds the digits below k.
+    x = 0;
+    int place = 1;
+    for (int k = 0; k < exponent; ++k) {
+        uint64_t rest = mod_mul(context, target, mod_pow(context, inverse, x));
+        uint64_t image = mod_pow(context, rest, order / place / prime);
+        uint64_t digit;
+        if (!bsgs_search(table, context, image, digit)) {
+            return DLOG_NO_SOLUTION;
+        }
+        x += digit * place;
+        place *= prime;
+    }
+    return DLOG_SOLVED;
+}
+
+
+// Solves base^x = target for 0 <= x < order, where base has the given order
+// and both are in the stored form. Solves modulo each prime power of the order
+// and merges the results with the CRT. Returns a DLOG_ status code.
+static int pohlig_hellman(const mod_context &context, uint64_t base,
+uint64_t target, int order, int &x) {
+    int solution = 0;
+    int modulus = 1;
+    for (int prime : distinct_prime_factors(order)) {
+        int power = 1;
+        int exponent = 0;
+        for (int rest = order; rest % prime == 0; rest /= prime) {
+            power *= prime;
+            ++exponent;
+        }
+
+        // The pieces of base and target with order dividing prime^exponent.
+        uint64_t cofactor = order / power;
+        int piece;
+        int status = prime_power_log(context, mod_pow(context, base, cofactor),
+        mod_pow(context, target, cofactor), power, prime, exponent, piece);
+        if (status != DLOG_SOLVED) {
+            return status;
+        }
+
+        // The prime powers are coprime and their product divides the order,
+        // so merging them cannot fail or overflow.
+        merge_congruences(solution, modulus, piece, power);
+    }
+
+    // The pieces only agree with a real solution if target is a power of base.
+    if (mod_pow(context, base, solution) != target) {
+        return DLOG_NO_SOLUTION;
+    }
+    x = solution;
+    return DLOG_SOLVED;
+}
+
+
+// Solves b^x = a (mod m) for m > 0, setting x to the smallest solution. If
+// b^x is periodic from x on, period is set so that the solutions are exactly
+// x + k * period for k >= 0. Otherwise period is 0. Uses Pohlig-Hellman over
+// the prime powers of the order of b, with baby-step giant-step for each
+// digit, and merges the pieces with the CRT. Returns a DLOG_ status code.
+int discrete_log(int b, int a, int m, int &x, int &period) {
+    b = b % m < 0 ? b % m + m : b % m;
+    a = a % m < 0 ? a % m + m : a % m;
+
+    // Divide out the factors b shares with m. For x >= shift, b^x = a (mod m)
+    // becomes coefficient * b^(x - shift) = a / divisors (mod reduced), where
+    // b is coprime to reduced. This fails if a is missing one of the factors.
+    int reduced = m;
+    int reduced_target = a;
+    int coefficient = 1 % m;
+    int shift = 0;
+    bool reducible = true;
+    for (int divisor = gcd(b, reduced); divisor != 1 && reducible;
+    divisor = gcd(b, reduced)) {
+        reducible = reduced_target % divisor == 0;
+        reduced_target /= divisor;
+        reduced /= divisor;
+        coefficient = int128(coefficient) * (b / divisor) % reduced;
+        ++shift;
+    }
+
+    // Small exponents are tried directly, which also finds the solutions that
+    // come before shift, where b^x is not yet periodic.
+    int brute_solution = -1;
+    int power = 1 % m;
+    for (int exponent = 0; exponent < DLOG_BRUTE_FORCE; ++exponent) {
+        if (power == a) {
+            brute_solution = exponent;
+            break;
+        }
+        power = int128(power) * b % m;
+    }
+    if (!reducible) {
+        x = brute_solution;
+        period = 0;
+        return brute_solution < 0 ? DLOG_NO_SOLUTION : DLOG_SOLVED;
+    }
+
+    int order = multiplicative_order(b % reduced, reduced);
+    if (brute_solution >= 0) {
+        x = brute_solution;
+        period = x >= shift ? order : 0;
+        return DLOG_SOLVED;
+    }
+
+    // b^y = target / coefficient (mod reduced), where the coefficient is
+    // made of factors of b, so it is invertible.
+    int target = int128(reduced_target) * mod_inverse(coefficient, reduced)
+    % reduced;
+    if (gcd(target, reduced) != 1) {
+        return DLOG_NO_SOLUTION;
+    }
+
+    mod_context context;
+    init_mod_context(context, reduced);
+    int y;
+    int status = pohlig_hellman(context, to_mod_form(context, b),
+    to_mod_form(context, target), order, y);
+    if (status != DLOG_SOLVED) {
+        return status;
+    }
+
+    x = y + shift;
+    period = order;
+    return DLOG_SOLVED;
+}
@@ -0,0 +1,81 @@
+/*
+Header file for discrete logarithm functions, which solve b^x = a (mod m).
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#ifndef DISCRETE_LOG_H
+#define DISCRETE_LOG_H
+
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "crt.h"
+#include "debug.h"
+#include "modular.h"
+#include "sieve.h"
+
+
+#define int long long
+#define int_vec std::vector<long long>
+
+#define MAX_DLOG_PRIME   1000000000000 // 10^12, so tables have 10^6 entries.
+#define DLOG_BRUTE_FORCE 64 // Exponents tried one by one before anything else.
+#define EMPTY_SLOT       UINT64_MAX
+#define HASH_MULTIPLIER  0x9E3779B97F4A7C15ULL // 2^64 over the golden ratio.
+
+#define DLOG_SOLVED      0
+#define DLOG_NO_SOLUTION 1
+#define DLOG_TOO_LARGE   2 // The order of b has a prime factor too large.
+
+#define RED   "\033[31m"
+#define RESET "\033[0m"
+
+
+// The baby steps g^j for 0 <= j < step_count of a generator g of prime order,
+// in a flat table with open addressing. A lookup is one multiplication and a
+// scan of neighbouring slots, with no allocation or pointer chasing. Values are
+// in the stored form of a mod_context.
+typedef struct bsgs_table {
+    u64_vec keys;
+    std::vector<uint32_t> steps;
+    int shift; // 64 minus the number of bits in the table size.
+    uint64_t step_count;
+    uint64_t giant; // g^-step_count, the giant step.
+    uint64_t order;
+} bsgs_table;
+
+
+// The main code that runs the discrete logarithm solver.
+int do_discrete_log(void);
+
+
+// Reads the base, the target and the modulus from the user.
+void take_input_discrete_log(int &base, int &target, int &m);
+
+
+// Fills the table with the baby steps of generator, which has the given prime
+// order, modulo the modulus of context.
+void init_bsgs_table(bsgs_table &table, const mod_context &context,
+uint64_t generator, uint64_t order);
+
+
+// Finds 0 <= exponent < order with g^exponent = target by baby-step giant-step,
+// for target in the stored form. Returns false if target is not a power of g.
+bool bsgs_search(const bsgs_table &table, const mod_context &context,
+uint64_t target, uint64_t &exponent);
+
+
+// Solves b^x = a (mod m) for m > 0, setting x to the smallest solution. If
+// b^x is periodic from x on, period is set so that the solutions are exactly
+// x + k * period for k >= 0. Otherwise period is 0. Uses Pohlig-Hellman over
+// the prime powers of the order of b, with baby-step giant-step for each
+// digit, and merges the pieces with the CRT. Returns a DLOG_ status code.
+int discrete_log(int b, int a, int m, int &x, int &period);
+
+
+#endif
@@ -2,7 +2,7 @@
 Implementation of Euclidean algorithm functions.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -116,6 +116,33 @@ void auto_silent_eea(int_v &q, int_v &r, int_v &x, int_v &y, int a, int b) {
 }
 
 
+// Finds g = gcd(a, b) and s, t with as + bt = g for non-negative a and b, not
+// both 0. Nothing is allocated. |s| <= b / g and |t| <= a / g, and products
+// are taken in 128 bits, so any 64-bit inputs are safe.
+int extended_gcd(int a, int b, int &s, int &t) {
+    // Keep only the last two rows of the table.
+    int r_prev = a;
+    int r = b;
+    int s_next = 0;
+    int t_next = 1;
+    s = 1;
+    t = 0;
+    while (r != 0) {
+        int quotient = r_prev / r;
+        int temp = r_prev - quotient * r;
+        r_prev = r;
+        r = temp;
+        temp = (int128)(s) - (int128)(quotient) * s_next;
+        s = s_next;
+        s_next = temp;
+        temp = (int128)(t) - (int128)(quotient) * t_next;
+        t = t_next;
+        t_next = temp;
+    }
+    return r_prev;
+}
+
+
 // Prints limitations for the Euclidean algorithm.
 void print_limitations_ea(void) {
     std::cerr << "Limitations:\n";
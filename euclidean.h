@@ -2,7 +2,7 @@
 Header file for Euclidean algorithm functions.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -54,6 +54,12 @@ void auto_eea(int_v &q, int_v &r, int_v &x, int_v &y, int a, int b);
 void auto_silent_eea(int_v &q, int_v &r, int_v &x, int_v &y, int a, int b);
 
 
+// Finds g = gcd(a, b) and s, t with as + bt = g for non-negative a and b, not
+// both 0. Nothing is allocated. |s| <= b / g and |t| <= a / g, and products
+// are taken in 128 bits, so any 64-bit inputs are safe.
+int extended_gcd(int a, int b, int &s, int &t);
+
+
 // Prints limitations for the Euclidean algorithm.
 void print_limitations_ea(void);
 
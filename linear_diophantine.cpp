@@ -2,7 +2,7 @@
 Implementation of linear Diophantine equation functions.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -132,3 +132,443 @@ void show_diophantine_soln(int x_const, int y_const, int xk, int yk) {
     std::cout << "y = " << y_const << " - " << yk << "k\n\n";
     return;
 }
+
+
+// The main code that counts and lists the solutions of a linear Diophantine
+// equation in a box.
+int do_lde_box(void) {
+    int a;
+    int b;
+    int c;
+    lde_box box;
+    take_input_lde_box(a, b, c, box);
+
+    lde_solution solution;
+    if (!solve_lde(a, b, c, solution)) {
+        std::cout << "\nThere are no solutions.\n\n";
+        return 0;
+    }
+    std::cout << "\n";
+    show_diophantine_soln(solution.x0, solution.y0, solution.xk, solution.yk);
+
+    int128 k_first;
+    int128 k_last;
+    uint128 count = lde_k_range(solution, box, k_first, k_last);
+    std::cout << "Solutions in the box: ";
+    std::cout << bigint_to_string(bigint_from_uint128(count)) << "\n";
+    if (count == 0) {
+        std::cout << "\n";
+        return 0;
+    }
+    std::cout << "They are k = " << int128_to_string(k_first) << " to k = ";
+    std::cout << int128_to_string(k_last) << ".\n\n";
+
+    char answer;
+    std::cerr << "Print every solution (y/n)? ";
+    if (std::cin >> answer && (answer == 'y' || answer == 'Y')) {
+        std::cout << "\n";
+        output_buffer out;
+        init_output_buffer(out, std::cout);
+        write_lde_solutions(solution, k_first, k_last, out);
+        flush_output(out);
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+
+// Returns the decimal representation of a 128-bit integer.
+str int128_to_string(int128 value) {
+    uint128 magnitude = value < 0 ? 0 - (uint128)(value) : value;
+    return (value < 0 ? "-" : "") + bigint_to_string(
+    bigint_from_uint128(magnitude));
+}
+
+
+// Reads one integer from user, or exits with an error message.
+static void read_lde_value(const char *prompt, int &value) {
+    std::cerr << prompt;
+    if (!(std::cin >> value)) {
+        std::cerr << RED << "Error reading input." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+    return;
+}
+
+
+// Reads positive coefficients, the constant and the box from user.
+void take_input_lde_box(int &a, int &b, int &c, lde_box &box) {
+    std::cerr << "Counts the solutions of ax + by = c with x and y in a ";
+    std::cerr << "box, for positive a and b.\n";
+    read_lde_value("Enter coefficient of x: ", a);
+    read_lde_value("Enter coefficient of y: ", b);
+    if (a <= 0 || b <= 0) {
+        std::cerr << RED << "Error: coefficients must be positive." << RESET;
+        std::cerr << "\n";
+        exit(EXIT_FAILURE);
+    }
+    read_lde_value("Enter value of c: ", c);
+    read_lde_value("Enter smallest x: ", box.x_min);
+    read_lde_value("Enter largest x: ", box.x_max);
+    read_lde_value("Enter smallest y: ", box.y_min);
+    read_lde_value("Enter largest y: ", box.y_max);
+    return;
+}
+
+
+// Solves ax + by = c for positive a and b, choosing the particular solution
+// with 0 <= x0 < xk. Returns false if there are no solutions. The results fit
+// in 64 bits for any a, b and c with |c| < 2^63.
+bool solve_lde(int a, int b, int c, lde_solution &solution) {
+    int s;
+    int t;
+    int gcd = extended_gcd(a, b, s, t);
+    if (c % gcd != 0) {
+        return false;
+    }
+
+    // x0 = (c / gcd) * s mod xk, where as + bt = gcd. Then
+    // |y0| = |c - a x0| / b <= (|c| + a (b - 1)) / b, which is at most
+    // max(|c|, a).
+    solution.xk = b / gcd;
+    solution.yk = a / gcd;
+    int128 x0 = (int128)(c / gcd % solution.xk) * (s % solution.xk)
+    % solution.xk;
+    if (x0 < 0) {
+        x0 += solution.xk;
+    }
+    solution.x0 = x0;
+    solution.y0 = ((int128)(c) - (int128)(a) * x0) / b;
+    return true;
+}
+
+
+// Solves every equation in a stream, writing one line per equation. Each
+// equation is a triple a b c for ax + by = c, and each line is 'x0 xk y0 yk'
+// from solve_lde, 'no solution', or 'invalid' if a or b is not positive.
+// Returns the number of equations read, or -1 if the input is malformed.
+int solve_lde_stream(std::istream &input, std::ostream &output) {
+    input_buffer in;
+    output_buffer out;
+    init_input_buffer(in, input);
+    init_output_buffer(out, output);
+
+    int equations = 0;
+    int a;
+    while (read_int(in, a)) {
+        int b;
+        int c;
+        if (!read_int(in, b) || !read_int(in, c)) {
+            flush_output(out);
+            return -1;
+        }
+        ++equations;
+
+        lde_solution solution;
+        if (a <= 0 || b <= 0) {
+            write_str(out, "invalid");
+        } else if (!solve_lde(a, b, c, solution)) {
+            write_str(out, "no solution");
+        } else {
+            write_int(out, solution.x0);
+            write_char(out, ' ');
+            write_int(out, solution.xk);
+            write_char(out, ' ');
+            write_int(out, solution.y0);
+            write_char(out, ' ');
+            write_int(out, solution.yk);
+        }
+        write_char(out, '\n');
+    }
+
+    flush_output(out);
+    return equations;
+}
+
+
+// The main code that solves linear Diophantine equations from a file.
+int do_lde_batch(void) {
+    std::cerr << "Each equation in the file is a triple a b c for ax + by = c.";
+    std::cerr << " One line 'x0 xk y0 yk'\nis printed per equation, where ";
+    std::cerr << "x = x0 + xk * k and y = y0 - yk * k.\n\n";
+
+    str file_name;
+    std::cerr << "Enter path to file: ";
+    if (!(std::cin >> file_name)) {
+        std::cerr << RED << "Error reading file name." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+    std::ifstream input(file_name);
+    if (!input.is_open()) {
+        std::cerr << RED << "Error: could not open '" << file_name << "'.";
+        std::cerr << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::ios::sync_with_stdio(false);
+    int count = solve_lde_stream(input, std::cout);
+    if (count < 0) {
+        std::cerr << RED << "Error: malformed equation in '" << file_name;
+        std::cerr << "'." << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << "\nSolved " << count << " equations.\n";
+    return 0;
+}
+
+
+// Returns a / b rounded down, for b > 0.
+static int128 floor_div(int128 a, int128 b) {
+    int128 quotient = a / b;
+    return quotient * b > a ? quotient - 1 : quotient;
+}
+
+
+// Returns a / b rounded up, for b > 0.
+static int128 ceil_div(int128 a, int128 b) {
+    int128 quotient = a / b;
+    return quotient * b < a ? quotient + 1 : quotient;
+}
+
+
+// Finds the first and last k for which a solution lies in box. Every k in
+// between works too, so this takes O(1) time. Returns the number of
+// solutions, which is 0 if k_first > k_last.
+uint128 lde_k_range(const lde_solution &solution, const lde_box &box,
+int128 &k_first, int128 &k_last) {
+    // x grows with k and y shrinks, so each bound limits k on one side.
+    int128 x_low = ceil_div((int128)(box.x_min) - solution.x0, solution.xk);
+    int128 x_high = floor_div((int128)(box.x_max) - solution.x0, solution.xk);
+    int128 y_low = ceil_div((int128)(solution.y0) - box.y_max, solution.yk);
+    int128 y_high = floor_div((int128)(solution.y0) - box.y_min, solution.yk);
+    k_first = std::max(x_low, y_low);
+    k_last = std::min(x_high, y_high);
+    return k_first > k_last ? 0 : (uint128)(k_last - k_first) + 1;
+}
+
+
+// Writes the solutions for k_first to k_last to out, one 'x y' per line.
+void write_lde_solutions(const lde_solution &solution, int128 k_first,
+int128 k_last, output_buffer &out) {
+    // Every solution written lies in the box, so x and y fit in 64 bits. Step
+    // from one solution to the next instead of multiplying each time.
+    int x = solution.x0 + solution.xk * k_first;
+    int y = solution.y0 - solution.yk * k_first;
+    for (int128 k = k_first; k <= k_last; ++k) {
+        if (k != k_first) {
+            x += solution.xk;
+            y -= solution.yk;
+        }
+        write_int(out, x);
+        write_char(out, ' ');
+        write_int(out, y);
+        write_char(out, '\n');
+    }
+    return;
+}
+
+
+// The main code that solves a system of linear Diophantine equations.
+int do_lde_system(void) {
+    big_matrix A;
+    big_vec b;
+    take_input_lde_system(A, b);
+
+    big_vec particular;
+    big_matrix basis;
+    if (!solve_lde_system(A, b, particular, basis)) {
+        std::cout << "\nThere are no integer solutions.\n\n";
+        return 0;
+    }
+
+    std::cout << "\nx = (";
+    for (size_t index = 0; index < particular.size(); ++index) {
+        std::cout << (index ? ", " : "") << bigint_to_string(particular[index]);
+    }
+    std::cout << ")";
+    for (size_t k = 0; k < basis.size(); ++k) {
+        std::cout << (k ? "\n  + " : " + ") << "k" << k + 1 << " * (";
+        for (size_t index = 0; index < basis[k].size(); ++index) {
+            std::cout << (index ? ", " : "");
+            std::cout << bigint_to_string(basis[k][index]);
+        }
+        std::cout << ")";
+    }
+    std::cout << "\n\n";
+    if (basis.empty()) {
+        std::cout << "This is the only solution.\n\n";
+    }
+    return 0;
+}
+
+
+// Reads the number of equations and variables, the coefficients A and the
+// constants b for A x = b from user.
+void take_input_lde_system(big_matrix &A, big_vec &b) {
+    std::cerr << "Solves A x = b for integer vectors x, where A holds the ";
+    std::cerr << "coefficients of one equation per row.\n";
+    int rows;
+    int columns;
+    read_lde_value("Enter number of equations: ", rows);
+    read_lde_value("Enter number of variables: ", columns);
+    if (rows <= 0 || columns <= 0 || rows > MAX_SYSTEM_SIZE
+    || columns > MAX_SYSTEM_SIZE) {
+        std::cerr << RED << "Error: there must be 1 to " << MAX_SYSTEM_SIZE;
+        std::cerr << " equations and variables." << RESET << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    A.assign(rows, big_vec(columns));
+    b.assign(rows, bigint());
+    for (int row = 0; row < rows; ++row) {
+        std::cerr << "Enter the " << columns << " coefficients and the ";
+        std::cerr << "constant of equation " << row + 1 << ": ";
+        for (int column = 0; column <= columns; ++column) {
+            int value;
+            if (!(std::cin >> value)) {
+                std::cerr << RED << "Error reading input." << RESET << "\n";
+                exit(EXIT_FAILURE);
+            }
+            if (column < columns) {
+                A[row][column] = bigint_from_int(value);
+            } else {
+                b[row] = bigint_from_int(value);
+            }
+        }
+    }
+    return;
+}
+
+
+// Replaces column j with column j - multiple * column k.
+static void subtract_column(big_matrix &columns, size_t j, size_t k,
+const bigint &multiple) {
+    for (size_t row = 0; row < columns[j].size(); ++row) {
+        columns[j][row] = bigint_sub(columns[j][row],
+        bigint_mul(multiple, columns[k][row]));
+    }
+    return;
+}
+
+
+// Finds every integer solution of A x = b, where A has one row per equation.
+// Column operations that keep the determinant at 1 bring A to its Hermite
+// normal form H = AU, which is solved by substitution. The solutions are
+// particular plus any integer combination of the vectors in basis, which
+// span the integer solutions of A x = 0. Returns false if there are none.
+bool solve_lde_system(const big_matrix &A, const big_vec &b,
+big_vec &particular, big_matrix &basis) {
+    size_t rows = A.size();
+    size_t variables = A[0].size();
+
+    // Column j holds column j of A on top of column j of U, which starts as
+    // the identity. Every operation is applied to both, so H = AU throughout.
+    big_matrix columns(variables, big_vec(rows + variables));
+    for (size_t j = 0; j < variables; ++j) {
+        for (size_t row = 0; row < rows; ++row) {
+            columns[j][row] = A[row][j];
+        }
+        columns[j][rows + j] = bigint_from_int(1);
+    }
+
+    // Clear each row to the right of its pivot, one pair of columns at a time.
+    // Rows with nothing left to clear have no pivot.
+    std::vector<size_t> pivot_of(rows, variables);
+    size_t rank = 0;
+    for (size_t row = 0; row < rows && rank < variables; ++row) {
+        while (true) {
+            // Move the column with the smallest nonzero entry in this row to
+            // the pivot position.
+            size_t smallest = variables;
+            for (size_t j = rank; j < variables; ++j) {
+                if (!bigint_is_zero(columns[j][row]) && (smallest == variables
+                || bigint_compare_abs(columns[j][row],
+                columns[smallest][row]) < 0)) {
+                    smallest = j;
+                }
+            }
+            if (smallest == variables) {
+                break;
+            }
+            std::swap(columns[rank], columns[smallest]);
+
+            // Subtract the nearest multiple of the pivot column from the
+            // others, like a step of the Euclidean algorithm on each entry.
+            // Rounding to the nearest multiple keeps the entries of U small.
+            bool cleared = true;
+            const bigint &pivot = columns[rank][row];
+            bigint twice_pivot = bigint_add(pivot, pivot);
+            for (size_t j = rank + 1; j < variables; ++j) {
+                if (bigint_is_zero(columns[j][row])) {
+                    continue;
+                }
+                bigint multiple = bigint_floor_div(bigint_add(bigint_add(
+                columns[j][row], columns[j][row]), pivot), twice_pivot);
+                subtract_column(columns, j, rank, multiple);
+                cleared = cleared && bigint_is_zero(columns[j][row]);
+            }
+            if (cleared) {
+                break;
+            }
+        }
+        if (bigint_is_zero(columns[rank][row])) {
+            continue;
+        }
+
+        // Make the pivot positive and reduce the entries to its left modulo
+        // it, which is what stops the numbers growing.
+        if (columns[rank][row].negative) {
+            for (size_t k = 0; k < rows + variables; ++k) {
+                columns[rank][k] = bigint_negate(columns[rank][k]);
+            }
+        }
+        for (size_t j = 0; j < rank; ++j) {
+            bigint multiple = bigint_floor_div(columns[j][row],
+            columns[rank][row]);
+            if (!bigint_is_zero(multiple)) {
+                subtract_column(columns, j, rank, multiple);
+            }
+        }
+        pivot_of[row] = rank;
+        ++rank;
+    }
+
+    // Solve H y = b from the top row down. Each row only involves columns
+    // already solved, apart from its pivot. Columns past the rank are free.
+    big_vec y(variables, bigint_from_int(0));
+    for (size_t row = 0; row < rows; ++row) {
+        bigint rest = b[row];
+        size_t end = pivot_of[row] == variables ? rank : pivot_of[row];
+        for (size_t j = 0; j < end; ++j) {
+            rest = bigint_sub(rest, bigint_mul(columns[j][row], y[j]));
+        }
+
+        if (pivot_of[row] == variables) {
+            if (!bigint_is_zero(rest)) {
+                return false;
+            }
+            continue;
+        }
+        bigint remainder;
+        bigint_divmod(rest, columns[pivot_of[row]][row], y[pivot_of[row]],
+        remainder);
+        if (!bigint_is_zero(remainder)) {
+            return false;
+        }
+    }
+
+    // x = Uy, and the columns of U past the rank solve A x = 0.
+    particular.assign(variables, bigint_from_int(0));
+    for (size_t j = 0; j < rank; ++j) {
+        for (size_t k = 0; k < variables; ++k) {
+            particular[k] = bigint_add(particular[k],
+            bigint_mul(y[j], columns[j][rows + k]));
+        }
+    }
+    basis.clear();
+    for (size_t j = rank; j < variables; ++j) {
+        basis.emplace_back(columns[j].begin() + rows, columns[j].end());
+    }
+    return true;
+}
@@ -2,7 +2,7 @@
 Header file for linear Diophantine equation functions.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -13,17 +13,42 @@ Last updated 19 August 2022.
 #include <cmath>
 #include <iostream>
 #include <vector>
+#include "bigint.h"
+#include "buffered_io.h"
 #include "debug.h"
 #include "euclidean.h"
 
 
 #define int long long
 #define int_vec std::vector<long long>
+#define big_vec std::vector<bigint>
+#define big_matrix std::vector<std::vector<bigint>>
+
+#define MAX_SYSTEM_SIZE 100 // Most equations or variables in a system.
 
 #define RED   "\033[31m"
 #define RESET "\033[0m"
 
 
+// The solutions x = x0 + xk * k and y = y0 - yk * k of ax + by = c, for every
+// integer k.
+typedef struct lde_solution {
+    int x0;
+    int xk;
+    int y0;
+    int yk;
+} lde_solution;
+
+
+// The solutions wanted, x_min <= x <= x_max and y_min <= y <= y_max.
+typedef struct lde_box {
+    int x_min;
+    int x_max;
+    int y_min;
+    int y_max;
+} lde_box;
+
+
 // The main code that runs the linear Diophantine equastion solver.
 int do_solve_lde(void);
 
@@ -45,4 +70,64 @@ void solve_diophantine(int c, int_v r, int_v x, int_v y);
 void show_diophantine_soln(int x_const, int y_const, int xk, int yk);
 
 
+// The main code that counts and lists the solutions of a linear Diophantine
+// equation in a box.
+int do_lde_box(void);
+
+
+// Reads positive coefficients, the constant and the box from user.
+void take_input_lde_box(int &a, int &b, int &c, lde_box &box);
+
+
+// Returns the decimal representation of a 128-bit integer.
+str int128_to_string(int128 value);
+
+
+// Solves ax + by = c for positive a and b, choosing the particular solution
+// with 0 <= x0 < xk. Returns false if there are no solutions. The results fit
+// in 64 bits for any a, b and c with |c| < 2^63.
+bool solve_lde(int a, int b, int c, lde_solution &solution);
+
+
+// Solves every equation in a stream, writing one line per equation. Each
+// equation is a triple a b c for ax + by = c, and each line is 'x0 xk y0 yk'
+// from solve_lde, 'no solution', or 'invalid' if a or b is not positive.
+// Returns the number of equations read, or -1 if the input is malformed.
+int solve_lde_stream(std::istream &input, std::ostream &output);
+
+
+// The main code that solves linear Diophantine equations from a file.
+int do_lde_batch(void);
+
+
+// Finds the first and last k for which a solution lies in box. Every k in
+// between works too, so this takes O(1) time. Returns the number of
+// solutions, which is 0 if k_first > k_last.
+uint128 lde_k_range(const lde_solution &solution, const lde_box &box,
+int128 &k_first, int128 &k_last);
+
+
+// Writes the solutions for k_first to k_last to out, one 'x y' per line.
+void write_lde_solutions(const lde_solution &solution, int128 k_first,
+int128 k_last, output_buffer &out);
+
+
+// The main code that solves a system of linear Diophantine equations.
+int do_lde_system(void);
+
+
+// Reads the number of equations and variables, the coefficients A and the
+// constants b for A x = b from user.
+void take_input_lde_system(big_matrix &A, big_vec &b);
+
+
+// Finds every integer solution of A x = b, where A has one row per equation.
+// Column operations that keep the determinant at 1 bring A to its Hermite
+// normal form H = AU, which is solved by substitution. The solutions are
+// particular plus any integer combination of the vectors in basis, which
+// span the integer solutions of A x = 0. Returns false if there are none.
+bool solve_lde_system(const big_matrix &A, const big_vec &b,
+big_vec &particular, big_matrix &basis);
+
+
 #endif
@@ -0,0 +1,196 @@
+/*
+Implementation of fast arithmetic modulo a fixed modulus.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#include "modular.h"
+
+
+// Returns the top 128 bits of the 256-bit product of a and b.
+static uint128 mul_high_128(uint128 a, uint128 b) {
+    uint64_t a_low = a;
+    uint64_t a_high = a >> 64;
+    uint64_t b_low = b;
+    uint64_t b_high = b >> 64;
+
+    uint128 low_low = uint128(a_low) * b_low;
+    uint128 low_high = uint128(a_low) * b_high;
+    uint128 high_low = uint128(a_high) * b_low;
+    uint128 high_high = uint128(a_high) * b_high;
+
+    // The middle column cannot overflow, as it is less than 3 * 2^64.
+    uint128 middle = (low_low >> 64) + uint64_t(low_high) + uint64_t(high_low);
+    return high_high + (low_high >> 64) + (high_low >> 64) + (middle >> 64);
+}
+
+
+// Reduces x < m * 2^64 to x / R mod m for an odd modulus (Montgomery's REDC).
+static uint64_t montgomery_reduce(const mod_context &context, uint128 x) {
+    // q is chosen so that x - qm is divisible by 2^64, so only the top halves
+    // need to be subtracted. m is added back with a mask rather than a branch,
+    // which would be mispredicted half the time.
+    uint64_t q = uint64_t(x) * context.inverse;
+    uint64_t high = x >> 64;
+    uint64_t subtract = (uint128(q) * context.modulus) >> 64;
+    uint64_t borrow = 0 - uint64_t(high < subtract);
+    return high - subtract + (context.modulus & borrow);
+}
+
+
+// Reduces x < m^2 to x mod m for an even modulus (Barrett reduction).
+static uint64_t barrett_reduce(const mod_context &context, uint128 x) {
+    // The estimated quotient is at most one too small.
+    uint128 quotient = mul_high_128(x, context.barrett);
+    uint64_t remainder = x - quotient * context.modulus;
+    return remainder >= context.modulus ? remainder - context.modulus
+    : remainder;
+}
+
+
+// Sets up a context for arithmetic modulo m, for 0 < m < 2^63.
+void init_mod_context(mod_context &context, uint64_t m) {
+    context.modulus = m;
+    context.montgomery = m % 2 == 1;
+    context.inverse = 0;
+    context.r_squared = 0;
+    context.barrett = 0;
+
+    if (context.montgomery) {
+        // Newton's method for the inverse of m modulo 2^64. m is its own
+        // inverse modulo 8, and each step doubles the number of correct bits.
+        uint64_t inverse = m;
+        for (int step = 0; step < MONTGOMERY_NEWTON_STEPS; ++step) {
+            inverse *= 2 - m * inverse;
+        }
+        context.inverse = inverse;
+
+        uint64_t r = (0 - m) % m;
+        context.r_squared = uint128(r) * r % m;
+        context.one = r;
+    } else {
+        context.barrett = ~uint128(0) / m;
+        context.one = 1 % m;
+    }
+
+    return;
+}
+
+
+// Converts x, which need not be reduced, into the stored form.
+uint64_t to_mod_form(const mod_context &context, uint64_t x) {
+    x %= context.modulus;
+    if (context.montgomery) {
+        return montgomery_reduce(context, uint128(x) * context.r_squared);
+    }
+    return x;
+}
+
+
+// Converts a value in the stored form back to an ordinary residue.
+uint64_t from_mod_form(const mod_context &context, uint64_t x) {
+    if (context.montgomery) {
+        return montgomery_reduce(context, x);
+    }
+    return x;
+}
+
+
+// Returns a * b for a and b in the stored form, in the stored form.
+uint64_t mod_mul(const mod_context &context, uint64_t a, uint64_t b) {
+    if (context.montgomery) {
+        return montgomery_reduce(context, uint128(a) * b);
+    }
+    return barrett_reduce(context, uint128(a) * b);
+}
+
+
+// Returns a + b for a and b in the stored form, in the stored form.
+uint64_t mod_add(const mod_context &context, uint64_t a, uint64_t b) {
+    // Both are below 2^63, so the sum cannot overflow.
+    uint64_t sum = a + b;
+    return sum >= context.modulus ? sum - context.modulus : sum;
+}
+
+
+// Returns base^exponent for base in the stored form, in the stored form.
+uint64_t mod_pow(const mod_context &context, uint64_t base, uint64_t exponent) {
+    // Multiply by base or by one with a mask rather than a branch, so that the
+    // chain of results runs alongside the chain of squares without stalling
+    // on mispredicted bits.
+    uint64_t result = context.one;
+    while (exponent) {
+        uint64_t mask = 0 - (exponent & 1);
+        result = mod_mul(context, result, context.one ^ ((base ^ context.one)
+        & mask));
+        base = mod_mul(context, base, base);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+
+// Sets results[i] to base^exponents[i] mod m, with base and results as
+// ordinary residues. The squarings of base are shared by every exponent, and
+// several exponents are worked on at once so that their multiplications
+// overlap.
+void batch_mod_pow(const mod_context &context, uint64_t base,
+const u64_vec &exponents, u64_vec &results) {
+    results.resize(exponents.size());
+    uint64_t largest = 0;
+    for (uint64_t exponent : exponents) {
+        largest |= exponent;
+    }
+
+    // squares[i] is base^(2^i), so each power only needs its multiplications.
+    u64_vec squares;
+    uint64_t square = to_mod_form(context, base);
+    for (uint64_t bits = largest; bits; bits >>= 1) {
+        squares.push_back(square);
+        square = mod_mul(context, square, square);
+    }
+
+    // The lanes are independent, so the processor can run their
+    // multiplications side by side. Choosing the reduction once, outside the
+    // loops, lets it be inlined.
+    auto run_lanes = [&](auto reduce) {
+        const size_t lanes = 4;
+        for (size_t first = 0; first < exponents.size(); first += lanes) {
+            uint64_t exponent[lanes];
+            uint64_t power[lanes];
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                size_t index = std::min(first + lane, exponents.size() - 1);
+                exponent[lane] = exponents[index];
+                power[lane] = context.one;
+            }
+
+            // Multiply by every square, or by one where the bit is clear. The
+            // factor is picked with a mask, as a branch on random exponent bits
+            // would be mispredicted half the time.
+            for (size_t bit = 0; bit < squares.size(); ++bit) {
+                uint64_t differ = squares[bit] ^ context.one;
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    uint64_t mask = 0 - (exponent[lane] >> bit & 1);
+                    uint64_t factor = context.one ^ (differ & mask);
+                    power[lane] = reduce(uint128(power[lane]) * factor);
+                }
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                if (first + lane < exponents.size()) {
+                    results[first + lane] = from_mod_form(context, power[lane]);
+                }
+            }
+        }
+    };
+
+    if (context.montgomery) {
+        run_lanes([&](uint128 x) { return montgomery_reduce(context, x); });
+    } else {
+        run_lanes([&](uint128 x) { return barrett_reduce(context, x); });
+    }
+
+    return;
+}
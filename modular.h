@@ -0,0 +1,73 @@
+/*
+Header file for fast arithmetic modulo a fixed modulus, used wherever many
+products are taken modulo the same number.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#ifndef MODULAR_H
+#define MODULAR_H
+
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "debug.h"
+
+
+#define u64_vec std::vector<uint64_t>
+
+#define MONTGOMERY_NEWTON_STEPS 5 // Correct bits of 1 / m go 3, 6, ..., 96.
+
+
+// Everything needed to multiply quickly modulo m, worked out once per modulus.
+// Odd moduli use Montgomery form, where x is stored as xR mod m for R = 2^64,
+// and products are reduced with the precomputed inverse of m. Even moduli use
+// Barrett reduction with floor((2^128 - 1) / m), and values are stored as they
+// are. Either way, a product costs a few 64-bit multiplications rather than a
+// 128-bit division. Requires 0 < m < 2^63.
+typedef struct mod_context {
+    uint64_t modulus;
+    bool montgomery;
+    uint64_t inverse;   // m * inverse = 1 (mod 2^64), for Montgomery form.
+    uint64_t r_squared; // R^2 mod m, for converting into Montgomery form.
+    uint128 barrett;    // floor((2^128 - 1) / m), for Barrett reduction.
+    uint64_t one;       // 1 in the stored form.
+} mod_context;
+
+
+// Sets up a context for arithmetic modulo m, for 0 < m < 2^63.
+void init_mod_context(mod_context &context, uint64_t m);
+
+
+// Converts x, which need not be reduced, into the stored form.
+uint64_t to_mod_form(const mod_context &context, uint64_t x);
+
+
+// Converts a value in the stored form back to an ordinary residue.
+uint64_t from_mod_form(const mod_context &context, uint64_t x);
+
+
+// Returns a * b for a and b in the stored form, in the stored form.
+uint64_t mod_mul(const mod_context &context, uint64_t a, uint64_t b);
+
+
+// Returns a + b for a and b in the stored form, in the stored form.
+uint64_t mod_add(const mod_context &context, uint64_t a, uint64_t b);
+
+
+// Returns base^exponent for base in the stored form, in the stored form.
+uint64_t mod_pow(const mod_context &context, uint64_t base, uint64_t exponent);
+
+
+// Sets results[i] to base^exponents[i] mod m, with base and results as
+// ordinary residues. The squarings of base are shared by every exponent, and
+// several exponents are worked on at once so that their multiplications
+// overlap.
+void batch_mod_pow(const mod_context &context, uint64_t base,
+const u64_vec &exponents, u64_vec &results);
+
+
+#endif
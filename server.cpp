@@ -0,0 +1,237 @@
+/*
+Implementation of server mode.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#include "batch.h"
+#include "server.h"
+
+
+// Runs the server from the command line arguments 'serve [--socket PATH]'.
+// Returns the exit status.
+int run_server(int32_t argc, char **argv) {
+    if (argc == 2) {
+        return serve_stream(std::cin, std::cout);
+    } else if (argc == 4 && str(argv[2]) == SOCKET_FLAG) {
+        return serve_socket(argv[3]);
+    }
+
+    std::cerr << RED << "Error: expected '2400 serve' or '2400 serve ";
+    std::cerr << SOCKET_FLAG << " PATH'." << RESET << "\n";
+    return EXIT_FAILURE;
+}
+
+
+// Answers one request line at a time from input, in the same format as batch
+// mode, until the input closes or a quit command arrives. Responses are flushed
+// whenever no more requests are waiting. Returns the exit status.
+int serve_stream(std::istream &input, std::ostream &output) {
+    std::ios::sync_with_stdio(false);
+    job_buffers buffers;
+    init_job_buffers(buffers);
+    str line;
+    str response;
+    while (std::getline(input, line)) {
+        if (line.size() && line[line.size() - 1] == '\r') {
+            line.pop_back();
+        }
+        if (line == QUIT_COMMAND || line == SHUTDOWN_COMMAND) {
+            break;
+        }
+
+        answer_job_line(line, buffers, response);
+        output << response << '\n';
+
+        // A client sending many requests at once gets its responses in one
+        // write, and a client waiting on each response gets it straight away.
+        if (input.rdbuf()->in_avail() <= 0) {
+            output.flush();
+        }
+    }
+
+    output.flush();
+    return 0;
+}
+
+
+#ifndef _WIN32
+
+
+// Writes all of data to a file descriptor. Returns false if the other end has
+// gone away.
+static bool write_all(int32_t fd, const str &data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t count = write(fd, data.data() + written, data.size() - written);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count <= 0) {
+            return false;
+        }
+        written += count;
+    }
+    return true;
+}
+
+
+// Reads whatever a client has sent and answers every complete request line in
+// it. Returns a CLIENT_ code saying whether the client is still connected, or
+// asked for the server to shut down.
+static int answer_client(client_state &client, job_buffers &buffers) {
+    char chunk[IO_BUFFER_SIZE];
+    ssize_t count = read(client.fd, chunk, sizeof(chunk));
+    if (count < 0 && errno == EINTR) {
+        return CLIENT_OPEN;
+    } else if (count <= 0) {
+        return CLIENT_CLOSED;
+    }
+    client.pending.append(chunk, count);
+
+    // Answer every complete line received so far.
+    str line;
+    str response;
+    str replies;
+    size_t start = 0;
+    size_t newline;
+    while ((newline = client.pending.find('\n', start)) != str::npos) {
+        line.assign(client.pending, start, newline - start);
+        start = newline + 1;
+        if (line.size() && line[line.size() - 1] == '\r') {
+            line.pop_back();
+        }
+
+        if (line == QUIT_COMMAND || line == SHUTDOWN_COMMAND) {
+            write_all(client.fd, replies);
+            return line == QUIT_COMMAND ? CLIENT_CLOSED : CLIENT_SHUTDOWN;
+        }
+        answer_job_line(line, buffers, response);
+        replies += response;
+        replies += '\n';
+    }
+    client.pending.erase(0, start);
+
+    if (client.pending.size() > MAX_REQUEST_SIZE) {
+        replies += "error: request too long\n";
+        write_all(client.fd, replies);
+        return CLIENT_CLOSED;
+    } else if (!write_all(client.fd, replies)) {
+        return CLIENT_CLOSED;
+    }
+    return CLIENT_OPEN;
+}
+
+
+// Listens on a Unix domain socket at path and serves every connected client,
+// answering whichever has sent a request, until a shutdown command arrives.
+// Returns the exit status.
+int serve_socket(const str &path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << RED << "Error: socket path too long." << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // Replace any socket left behind by an earlier server.
+    int32_t listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listener < 0
+    || bind(listener, (sockaddr *)(&address), sizeof(address)) < 0
+    || listen(listener, SOMAXCONN) < 0) {
+        std::cerr << RED << "Error: could not listen on '" << path << "': ";
+        std::cerr << strerror(errno) << "." << RESET << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // A client that disconnects early should not kill the server.
+    signal(SIGPIPE, SIG_IGN);
+    std::cerr << "Listening on " << path << ".\n";
+
+    // The buffers and caches are shared by every client. Requests are answered
+    // one at a time, but a client only holds up the others while one of its
+    // requests is running, not while it is idle.
+    job_buffers buffers;
+    init_job_buffers(buffers);
+    std::vector<client_state> clients;
+    std::vector<pollfd> polled;
+    int status = 0;
+    bool running = true;
+    while (running) {
+        polled.assign(1, {listener, POLLIN, 0});
+        for (const client_state &client : clients) {
+            polled.push_back({(int32_t)(client.fd), POLLIN, 0});
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << RED << "Error: could not wait for clients: ";
+            std::cerr << strerror(errno) << "." << RESET << "\n";
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        // Answer every client with something to read, back to front so that
+        // closed clients can be removed as we go.
+        for (size_t index = clients.size(); index-- > 0 && running;) {
+            if (!polled[index + 1].revents) {
+                continue;
+            }
+            int state = answer_client(clients[index], buffers);
+            if (state != CLIENT_OPEN) {
+                close(clients[index].fd);
+                clients.erase(clients.begin() + index);
+            }
+            running = state != CLIENT_SHUTDOWN;
+        }
+
+        if (running && (polled[0].revents & POLLIN)) {
+            int32_t client = accept(listener, nullptr, nullptr);
+            if (client < 0 && errno != EINTR && errno != ECONNABORTED) {
+                std::cerr << RED << "Error: could not accept a client: ";
+                std::cerr << strerror(errno) << "." << RESET << "\n";
+                status = EXIT_FAILURE;
+                break;
+            } else if (client >= 0 && clients.size() >= MAX_CLIENTS) {
+                write_all(client, "error: too many clients\n");
+                close(client);
+            } else if (client >= 0) {
+                // A client that stops reading its responses is dropped rather
+                // than blocking everyone else.
+                timeval timeout = {WRITE_TIMEOUT, 0};
+                setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout,
+                sizeof(timeout));
+                clients.push_back({client, ""});
+            }
+        }
+    }
+
+    for (const client_state &client : clients) {
+        close(client.fd);
+    }
+    close(listener);
+    unlink(path.c_str());
+    return status;
+}
+
+
+#else
+
+
+// Listens on a Unix domain socket at path and serves every connected client,
+// answering whichever has sent a request, until a shutdown command arrives.
+// Returns the exit status.
+int serve_socket(const str &path) {
+    std::cerr << RED << "Error: sockets are not supported on this system, ";
+    std::cerr << "use '2400 serve' over stdin instead of '" << path << "'.";
+    std::cerr << RESET << "\n";
+    return EXIT_FAILURE;
+}
+
+
+#endif
@@ -0,0 +1,59 @@
+/*
+Header file for server mode, which answers requests from a long-running process
+so that caches stay warm and process startup is only paid once.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#ifndef SERVER_H
+#define SERVER_H
+
+
+#include <iostream>
+#include <string>
+#include "debug.h"
+
+
+#define SOCKET_FLAG      "--socket"
+#define QUIT_COMMAND     "quit"     // Ends the current connection.
+#define SHUTDOWN_COMMAND "shutdown" // Ends the current connection and server.
+#define MAX_REQUEST_SIZE 1048576    // 2^20 bytes in a single request line.
+#define MAX_CLIENTS      64         // Clients connected to a socket at once.
+#define WRITE_TIMEOUT    10         // Seconds a client has to take a response.
+
+#define CLIENT_OPEN     0 // Return values of answer_client().
+#define CLIENT_CLOSED   1
+#define CLIENT_SHUTDOWN 2
+
+#define RED   "\033[31m"
+#define RESET "\033[0m"
+
+
+// A client of the socket server and the part of a request line it has sent so
+// far.
+typedef struct client_state {
+    int32_t fd;
+    str pending;
+} client_state;
+
+
+// Runs the server from the command line arguments 'serve [--socket PATH]'.
+// Returns the exit status.
+int run_server(int32_t argc, char **argv);
+
+
+// Answers one request line at a time from input, in the same format as batch
+// mode, until the input closes or a quit command arrives. Responses are flushed
+// whenever no more requests are waiting. Returns the exit status.
+int serve_stream(std::istream &input, std::ostream &output);
+
+
+// Listens on a Unix domain socket at path and serves every connected client,
+// answering whichever has sent a request, until a shutdown command arrives.
+// Returns the exit status.
+int serve_socket(const str &path);
+
+
+#endif
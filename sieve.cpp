@@ -2,7 +2,7 @@
 Header file for prime sieves.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -104,3 +104,155 @@ bool_vec raw_eratosthenes(int n) {
 
     return result;
 }
+
+
+// Returns how many primes are at most n, which are the first entries of
+// cache.primes. Sieves again only if n is beyond the cached limit.
+size_t cached_prime_count(prime_cache &cache, int n) {
+    if (n > cache.limit) {
+        // Grow geometrically so that slowly increasing requests do not sieve
+        // every time, but never beyond the large input size unless asked.
+        int limit = std::min(2 * cache.limit, (int)(LARGE_INPUT_SIZE));
+        limit = std::max(limit, (int)(MIN_CACHE_SIZE));
+        cache.limit = std::max(n, limit);
+        cache.primes = eratosthenes(cache.limit);
+    }
+
+    return std::upper_bound(cache.primes.begin(), cache.primes.end(), n)
+    - cache.primes.begin();
+}
+
+
+// Returns whether n is prime, using Miller-Rabin with bases that make it exact
+// for every 64-bit n.
+bool is_prime(int n) {
+    static const int bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    if (n < 2) {
+        return false;
+    }
+    for (int base : bases) {
+        if (n % base == 0) {
+            return n == base;
+        }
+    }
+
+    // Write n - 1 = odd * 2^shift.
+    uint64_t odd = n - 1;
+    int shift = 0;
+    while (odd % 2 == 0) {
+        odd /= 2;
+        ++shift;
+    }
+
+    // Work in Montgomery form throughout, comparing against 1 and -1 in that
+    // form rather than converting back.
+    mod_context context;
+    init_mod_context(context, n);
+    uint64_t minus_one = context.modulus - context.one;
+    for (int base : bases) {
+        uint64_t x = mod_pow(context, to_mod_form(context, base), odd);
+        if (x == context.one || x == minus_one) {
+            continue;
+        }
+        bool witness = true;
+        for (int round = 1; round < shift && witness; ++round) {
+            x = mod_mul(context, x, x);
+            witness = x != minus_one;
+        }
+        if (witness) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Returns a non-trivial factor of an odd composite n, using Brent's version of
+// Pollard's rho with the differences multiplied together in batches so that
+// only one GCD is taken per batch.
+static int pollard_rho(int n) {
+    // Multiplying by 2^64 is a bijection modulo odd n, so the walk and the GCDs
+    // can stay in Montgomery form.
+    const int batch = 128;
+    mod_context context;
+    init_mod_context(context, n);
+    for (uint64_t c = 1; ; ++c) {
+        auto step = [&](uint64_t x) {
+            return mod_add(context, mod_mul(context, x, x), c);
+        };
+        uint64_t x = 2;
+        uint64_t y = 2;
+        uint64_t saved = 2;
+        uint64_t product = 1;
+        int factor = 1;
+        for (int length = 1; factor == 1; length *= 2) {
+            x = y;
+            for (int i = 0; i < length; ++i) {
+                y = step(y);
+            }
+            for (int done = 0; done < length && factor == 1; done += batch) {
+                saved = y;
+                for (int i = 0; i < std::min(batch, length - done); ++i) {
+                    y = step(y);
+                    product = mod_mul(context, product, x > y ? x - y : y - x);
+                }
+                factor = std::gcd(product, n);
+            }
+        }
+
+        // The batch overshot, so step through it again one at a time.
+        if (factor == n) {
+            do {
+                saved = step(saved);
+                factor = std::gcd(x > saved ? x - saved : saved - x, n);
+            } while (factor == 1);
+        }
+        if (factor != n) {
+            return factor;
+        }
+    }
+}
+
+
+// Adds the prime factors of n to factors, with repeats.
+static void factor_with_rho(int n, int_vec &factors) {
+    if (n == 1) {
+        return;
+    } else if (is_prime(n)) {
+        factors.push_back(n);
+        return;
+    }
+
+    int factor = pollard_rho(n);
+    factor_with_rho(factor, factors);
+    factor_with_rho(n / factor, factors);
+    return;
+}
+
+
+// Returns the distinct prime factors of a positive n in increasing order. Small
+// factors are found by trial division and the rest by Pollard's rho, so any
+// 64-bit n is factored quickly.
+int_vec distinct_prime_factors(int n) {
+    int_vec factors;
+    for (int divisor = 2; divisor < TRIAL_DIVISORS && divisor * divisor <= n;
+    divisor += divisor == 2 ? 1 : 2) {
+        if (n % divisor == 0) {
+            factors.push_back(divisor);
+            while (n % divisor == 0) {
+                n /= divisor;
+            }
+        }
+    }
+
+    // Whatever is left has no factors below TRIAL_DIVISORS.
+    if (n >= TRIAL_DIVISORS * TRIAL_DIVISORS) {
+        factor_with_rho(n, factors);
+        std::sort(factors.begin(), factors.end());
+        factors.erase(std::unique(factors.begin(), factors.end()),
+        factors.end());
+    } else if (n > 1) {
+        factors.push_back(n);
+    }
+    return factors;
+}
@@ -2,7 +2,7 @@
 Header file for prime sieves.
 
 Written by Stephen Chuang.
-Last updated 19 August 2022.
+Last updated 18 October 2026.
 */
 
 
@@ -11,8 +11,10 @@ Last updated 19 August 2022.
 
 
 #include <iostream>
+#include <numeric>
 #include <vector>
 #include "debug.h"
+#include "modular.h"
 
 
 #define bool_vec std::vector<bool>
@@ -20,12 +22,22 @@ Last updated 19 August 2022.
 #define int_vec std::vector<long long>
 
 #define LARGE_INPUT_SIZE 20000000 // 2 * 10^7
+#define MIN_CACHE_SIZE   65536    // Smallest limit a prime cache sieves to.
+#define TRIAL_DIVISORS   1000     // Larger factors are found by Pollard's rho.
 
 #define YELLOW "\033[33m"
 #define RED    "\033[31m"
 #define RESET  "\033[0m"
 
 
+// Primes kept between requests, so that a long-running process only sieves
+// again when asked about numbers beyond the largest limit so far.
+typedef struct prime_cache {
+    int limit;
+    int_vec primes;
+} prime_cache;
+
+
 // The main code that runs the sieve of Eratosthenes and prints output to a file
 // primes.txt.
 int do_eratosthenes(void);
@@ -48,4 +60,20 @@ int_vec eratosthenes(int n);
 bool_vec raw_eratosthenes(int n);
 
 
+// Returns how many primes are at most n, which are the first entries of
+// cache.primes. Sieves again only if n is beyond the cached limit.
+size_t cached_prime_count(prime_cache &cache, int n);
+
+
+// Returns whether n is prime, using Miller-Rabin with bases that make it exact
+// for every 64-bit n.
+bool is_prime(int n);
+
+
+// Returns the distinct prime factors of a positive n in increasing order. Small
+// factors are found by trial division and the rest by Pollard's rho, so any
+// 64-bit n is factored quickly.
+int_vec distinct_prime_factors(int n);
+
+
 #endif
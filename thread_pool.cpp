@@ -0,0 +1,119 @@
+/*
+Implementation of a work-stealing thread pool.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#include "thread_pool.h"
+
+
+// Takes a task for worker id, first from its own queue and then by stealing
+// from the others. Returns false if every queue is empty.
+static bool take_task(thread_pool &pool, size_t id, pool_task &task) {
+    size_t count = pool.queues.size();
+    for (size_t offset = 0; offset < count; ++offset) {
+        work_queue &queue = pool.queues[(id + offset) % count];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        // Steal the task the owner would have reached last.
+        if (offset == 0) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        } else {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        --pool.queued;
+        return true;
+    }
+    return false;
+}
+
+
+// Runs tasks until the pool stops.
+static void worker_loop(thread_pool &pool, size_t id) {
+    pool_task task;
+    while (true) {
+        if (take_task(pool, id, task)) {
+            task(id);
+            if (--pool.pending == 0) {
+                std::lock_guard<std::mutex> guard(pool.lock);
+                pool.done.notify_all();
+            }
+            continue;
+        }
+
+        // Sleep until there is something to do. Submitters count new tasks
+        // under the pool lock, so a wake up cannot be missed.
+        std::unique_lock<std::mutex> guard(pool.lock);
+        pool.wake.wait(guard, [&]() {
+            return pool.stopping || pool.queued > 0;
+        });
+        if (pool.stopping && pool.queued == 0) {
+            return;
+        }
+    }
+}
+
+
+// Starts a pool with the given number of workers.
+void init_thread_pool(thread_pool &pool, size_t threads) {
+    threads = std::max(threads, (size_t)(1));
+    pool.queues = std::vector<work_queue>(threads);
+    pool.queued = 0;
+    pool.pending = 0;
+    pool.next_queue = 0;
+    pool.stopping = false;
+    for (size_t id = 0; id < threads; ++id) {
+        pool.workers.emplace_back(worker_loop, std::ref(pool), id);
+    }
+    return;
+}
+
+
+// Queues a task. Tasks are spread over the workers in turn.
+void submit_task(thread_pool &pool, const pool_task &task) {
+    {
+        // Count the task while its queue is locked, so that no worker can
+        // take it before it is counted.
+        std::lock_guard<std::mutex> guard(pool.lock);
+        work_queue &queue = pool.queues[pool.next_queue];
+        pool.next_queue = (pool.next_queue + 1) % pool.queues.size();
+        std::lock_guard<std::mutex> queue_guard(queue.lock);
+        queue.tasks.push_back(task);
+        ++pool.pending;
+        ++pool.queued;
+    }
+    pool.wake.notify_one();
+    return;
+}
+
+
+// Waits until every task submitted so far has finished.
+void wait_for_tasks(thread_pool &pool) {
+    std::unique_lock<std::mutex> guard(pool.lock);
+    pool.done.wait(guard, [&]() {
+        return pool.pending == 0;
+    });
+    return;
+}
+
+
+// Finishes any queued tasks, then stops and joins the workers.
+void stop_thread_pool(thread_pool &pool) {
+    {
+        std::lock_guard<std::mutex> guard(pool.lock);
+        pool.stopping = true;
+    }
+    pool.wake.notify_all();
+    for (std::thread &worker : pool.workers) {
+        worker.join();
+    }
+    pool.workers.clear();
+    return;
+}
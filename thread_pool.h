@@ -0,0 +1,67 @@
+/*
+Header file for a work-stealing thread pool, used to run many independent jobs
+of uneven cost at once.
+
+Written by Stephen Chuang.
+Last updated 18 October 2026.
+*/
+
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "debug.h"
+
+
+// A task is given the index of the worker running it, so that it can use that
+// worker's own buffers without locking.
+#define pool_task std::function<void(size_t)>
+
+
+// The tasks queued on one worker. The owner takes from the front and idle
+// workers steal from the back.
+typedef struct work_queue {
+    std::mutex lock;
+    std::deque<pool_task> tasks;
+} work_queue;
+
+
+// A fixed set of workers, each with its own queue.
+typedef struct thread_pool {
+    std::vector<std::thread> workers;
+    std::vector<work_queue> queues;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::atomic<size_t> queued;
+    std::atomic<size_t> pending;
+    size_t next_queue;
+    bool stopping;
+} thread_pool;
+
+
+// Starts a pool with the given number of workers.
+void init_thread_pool(thread_pool &pool, size_t threads);
+
+
+// Queues a task. Tasks are spread over the workers in turn.
+void submit_task(thread_pool &pool, const pool_task &task);
+
+
+// Waits until every task submitted so far has finished.
+void wait_for_tasks(thread_pool &pool);
+
+
+// Finishes any queued tasks, then stops and joins the workers.
+void stop_thread_pool(thread_pool &pool);
+
+
+#endif